@@ -0,0 +1,150 @@
+#include "Autopilot.h"
+#include <string.h>
+
+#define DIST_UNSEEN 0xFFFF
+
+static const directions moves[4] = {up, right, down, left};
+static const int8_t move_dx[4] = {0, 1, 0, -1};
+static const int8_t move_dy[4] = {-1, 0, 1, 0};
+
+static inline uint16_t cell_of(int x, int y)
+{
+    return (y - 1) * SNAKE_WIDTH + (x - 1);
+}
+
+static inline bool is_reverse(directions a, directions b)
+{
+    return (a == up && b == down) || (a == down && b == up) ||
+           (a == left && b == right) || (a == right && b == left);
+}
+
+Autopilot::Autopilot(uint16_t budget)
+{
+    _budget = budget;
+    reset();
+}
+
+void Autopilot::reset()
+{
+    _expanded = 0;
+    _target.x = 0;
+    _target.y = 0;
+    _done = true;
+    _qhead = 0;
+    _qtail = 0;
+}
+
+directions Autopilot::next(const SnakeGame &game)
+{
+    _expanded = 0;
+
+    if (game.fruit.x != _target.x || game.fruit.y != _target.y) {
+        restart(game);
+    }
+
+    if (!_done && !search(game)) {
+        return fallback(game);
+    }
+
+    // walk down the distance field, rechecking the live body
+    uint16_t best = DIST_UNSEEN;
+    directions dir = null;
+    for (uint8_t i = 0; i < 4; i++) {
+        int x = game.head.x + move_dx[i];
+        int y = game.head.y + move_dy[i];
+        if (game.occupied(x, y) || is_reverse(moves[i], game.dir)) {
+            continue;
+        }
+        uint16_t d = _dist[cell_of(x, y)];
+        if (d < best) {
+            best = d;
+            dir = moves[i];
+        }
+    }
+
+    if (dir == null) {
+        // no known way to the fruit from here: search again next tick
+        restart(game);
+        return fallback(game);
+    }
+    return dir;
+}
+
+void Autopilot::restart(const SnakeGame &game)
+{
+    _target = game.fruit;
+    memset(_dist, 0xFF, sizeof(_dist)); // DIST_UNSEEN everywhere
+
+    _qhead = 0;
+    _qtail = 0;
+    _done = game.occupied(_target.x, _target.y);
+    if (!_done) {
+        uint16_t root = cell_of(_target.x, _target.y);
+        _dist[root] = 0;
+        _queue[_qtail++] = root;
+    }
+}
+
+bool Autopilot::search(const SnakeGame &game)
+{
+    uint16_t goal = cell_of(game.head.x, game.head.y);
+
+    while (_qhead != _qtail) {
+        if (_expanded == _budget) {
+            return false;
+        }
+        _expanded++;
+
+        uint16_t cell = _queue[_qhead++];
+        int x = cell % SNAKE_WIDTH + 1;
+        int y = cell / SNAKE_WIDTH + 1;
+
+        for (uint8_t i = 0; i < 4; i++) {
+            int nx = x + move_dx[i];
+            int ny = y + move_dy[i];
+            if (nx < 1 || nx > SNAKE_WIDTH || ny < 1 || ny > SNAKE_HEIGHT) {
+                continue;
+            }
+            uint16_t n = cell_of(nx, ny);
+            if (_dist[n] != DIST_UNSEEN) {
+                continue;
+            }
+            if (n == goal) {
+                // BFS order: the cell that reached the head is on a shortest path
+                _dist[n] = _dist[cell] + 1;
+                _done = true;
+                return true;
+            }
+            if (game.occupied(nx, ny)) {
+                continue;
+            }
+            _dist[n] = _dist[cell] + 1;
+            _queue[_qtail++] = n;
+        }
+    }
+
+    _done = true;
+    return true;
+}
+
+directions Autopilot::fallback(const SnakeGame &game)
+{
+    // keep going straight when it is safe, otherwise take any free cell
+    for (uint8_t i = 0; i < 4; i++) {
+        if (moves[i] != game.dir) {
+            continue;
+        }
+        if (!game.occupied(game.head.x + move_dx[i], game.head.y + move_dy[i])) {
+            return game.dir;
+        }
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        if (is_reverse(moves[i], game.dir)) {
+            continue;
+        }
+        if (!game.occupied(game.head.x + move_dx[i], game.head.y + move_dy[i])) {
+            return moves[i];
+        }
+    }
+    return game.dir;
+}
@@ -0,0 +1,78 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Piloto automatico para el modo demo: busqueda en anchura hacia la fruta con presupuesto por tick
+*/
+
+#ifndef AUTOPILOT_H_
+    #define AUTOPILOT_H_
+
+#include <stdint.h>
+#include <SnakeGame.h>
+
+    // Celdas expandidas como maximo en cada tick
+    #define AUTOPILOT_BUDGET 256
+
+/**
+ * @brief Plays Snake without joystick input
+ * @details Runs a breadth first search rooted at the fruit over the playfield,
+ * treating the body as walls, and steers the head down the distance field.
+ * The search is resumable: each call to next() expands at most `budget`
+ * cells and carries the queue over to the following tick, so the cost per
+ * tick is bounded no matter how big the board or the snake is. A finished
+ * field stays valid while the fruit does not move, because the only cells
+ * that become body are the ones the head walks through.
+ *
+ * While the search is still running, or when the fruit cannot be reached, the
+ * pilot falls back to the first safe move (straight ahead if possible).
+ *
+ * Memory is static: a queue and a distance table of SNAKE_CELLS entries each.
+ */
+class Autopilot
+{
+public:
+    /**
+     * @brief constructor
+     *
+     * @param budget maximum number of cells expanded per call to next()
+     */
+    Autopilot(uint16_t budget = AUTOPILOT_BUDGET);
+
+    /**
+     * @brief forgets the current search, call when a new game starts
+     */
+    void reset();
+
+    /**
+     * @brief picks the direction for the coming tick
+     *
+     * @param game game to play
+     *
+     * @return direction to pass to SnakeGame::turn()
+     */
+    directions next(const SnakeGame &game);
+
+    /**
+     * @brief cells expanded during the last call to next()
+     */
+    uint16_t expanded() const { return _expanded; }
+
+private:
+    void restart(const SnakeGame &game);
+    bool search(const SnakeGame &game);
+    directions fallback(const SnakeGame &game);
+
+    uint16_t _budget;
+    uint16_t _expanded;
+
+    objeto _target;
+    bool _done;
+
+    uint16_t _queue[SNAKE_CELLS];
+    uint16_t _qhead;
+    uint16_t _qtail;
+    uint16_t _dist[SNAKE_CELLS];
+};
+
+#endif /* !AUTOPILOT_H_ */
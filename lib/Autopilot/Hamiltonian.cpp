@@ -0,0 +1,116 @@
+#include "Hamiltonian.h"
+#include <string.h>
+
+// direction codes stored in the table
+#define CODE_UP 0
+#define CODE_RIGHT 1
+#define CODE_DOWN 2
+#define CODE_LEFT 3
+
+// cells kept free between the new head and the tail when taking a shortcut
+#define SHORTCUT_MARGIN 3
+
+static const directions code_dirs[4] = {up, right, down, left};
+static const int8_t code_dx[4] = {0, 1, 0, -1};
+static const int8_t code_dy[4] = {-1, 0, 1, 0};
+
+static inline uint16_t distance(uint16_t from, uint16_t to)
+{
+    return (to + SNAKE_CELLS - from) % SNAKE_CELLS;
+}
+
+HamiltonianPilot::HamiltonianPilot()
+{
+    memset(_dirs, 0, sizeof(_dirs));
+}
+
+void HamiltonianPilot::init()
+{
+    memset(_dirs, 0, sizeof(_dirs));
+
+    // 0 based coordinates: cx 0..SNAKE_WIDTH-1, cy 0..SNAKE_HEIGHT-1
+    for (int cy = 0; cy < SNAKE_HEIGHT; cy++) {
+        for (int cx = 0; cx < SNAKE_WIDTH; cx++) {
+            uint8_t code;
+            if (cy == 0) {
+                code = (cx == SNAKE_WIDTH - 1) ? CODE_DOWN : CODE_RIGHT;
+            } else if (cx == 0) {
+                code = CODE_UP; // way back to the start
+            } else if (cy % 2) {
+                // odd rows run right to left; the last one leads into column 0
+                code = (cx > 1 || cy == SNAKE_HEIGHT - 1) ? CODE_LEFT : CODE_DOWN;
+            } else {
+                code = (cx < SNAKE_WIDTH - 1) ? CODE_RIGHT : CODE_DOWN;
+            }
+
+            uint16_t cell = cy * SNAKE_WIDTH + cx;
+            _dirs[cell / 4] |= code << ((cell % 4) * 2);
+        }
+    }
+}
+
+directions HamiltonianPilot::cycle_dir(int x, int y) const
+{
+    uint16_t cell = (y - 1) * SNAKE_WIDTH + (x - 1);
+    return code_dirs[(_dirs[cell / 4] >> ((cell % 4) * 2)) & 0x3];
+}
+
+uint16_t HamiltonianPilot::order(int x, int y)
+{
+    int cx = x - 1;
+    int cy = y - 1;
+
+    if (cy == 0) {
+        return cx;
+    }
+    if (cx == 0) {
+        // column 0 is walked bottom to top after the serpentine
+        return SNAKE_WIDTH + (SNAKE_HEIGHT - 1) * (SNAKE_WIDTH - 1) + (SNAKE_HEIGHT - 1 - cy);
+    }
+
+    uint16_t base = SNAKE_WIDTH + (cy - 1) * (SNAKE_WIDTH - 1);
+    return base + ((cy % 2) ? (SNAKE_WIDTH - 1 - cx) : (cx - 1));
+}
+
+directions HamiltonianPilot::next(const SnakeGame &game) const
+{
+    directions dir = cycle_dir(game.head.x, game.head.y);
+
+    int len = game.length() + 1;
+    int empty = SNAKE_CELLS - len - 1;
+    if (empty < SNAKE_CELLS / 2) {
+        return dir; // long snake: stick to the cycle
+    }
+
+    objeto tail = game.tail();
+    uint16_t head_i = order(game.head.x, game.head.y);
+    int to_fruit = distance(head_i, order(game.fruit.x, game.fruit.y));
+    int to_tail = distance(head_i, order(tail.x, tail.y));
+
+    // how far ahead along the cycle the head may jump without catching the tail
+    int available = to_tail - len - SHORTCUT_MARGIN;
+    if (to_fruit < to_tail) {
+        available -= 1; // the snake grows on the way
+        if ((to_tail - to_fruit) * 4 > empty) {
+            available -= 10; // the next fruit may well land right in front
+        }
+    }
+    if (available > to_fruit) {
+        available = to_fruit;
+    }
+
+    int best = 1;
+    for (uint8_t i = 0; i < 4; i++) {
+        int x = game.head.x + code_dx[i];
+        int y = game.head.y + code_dy[i];
+        if (game.occupied(x, y)) {
+            continue;
+        }
+        int d = distance(head_i, order(x, y));
+        if (d > best && d <= available) {
+            best = d;
+            dir = code_dirs[i];
+        }
+    }
+    return dir;
+}
@@ -0,0 +1,71 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Piloto perfecto: sigue un ciclo hamiltoniano del area de juego con atajos hacia la fruta
+*/
+
+#ifndef HAMILTONIAN_H_
+    #define HAMILTONIAN_H_
+
+#include <stdint.h>
+#include <SnakeGame.h>
+
+#if (SNAKE_HEIGHT % 2) != 0
+#error "the Hamiltonian cycle needs an even number of rows"
+#endif
+
+/**
+ * @brief Plays Snake without ever dying
+ * @details Follows a Hamiltonian cycle that visits every playfield cell once:
+ * row 1 left to right, the remaining rows as a serpentine over columns
+ * 2..SNAKE_WIDTH, and column 1 back up to the start. Since the body always
+ * lies on the stretch of the cycle behind the head, following the cycle can
+ * never hit it, and the snake eventually fills the board.
+ *
+ * The successor of every cell is stored as a 2 bit direction code (SNAKE_CELLS
+ * / 4 bytes), built by init() in a single pass. While the snake is short, each
+ * step may skip ahead along the cycle towards the fruit, as long as the new
+ * head stays well before the tail; each step looks at the 4 neighbours only.
+ */
+class HamiltonianPilot
+{
+public:
+    HamiltonianPilot();
+
+    /**
+     * @brief builds the direction table, call once at startup
+     */
+    void init();
+
+    /**
+     * @brief picks the direction for the coming tick
+     *
+     * @param game game to play
+     *
+     * @return direction to pass to SnakeGame::turn()
+     */
+    directions next(const SnakeGame &game) const;
+
+    /**
+     * @brief direction of the cycle leaving a cell
+     *
+     * @param x column (1-SNAKE_WIDTH)
+     * @param y row (1-SNAKE_HEIGHT)
+     */
+    directions cycle_dir(int x, int y) const;
+
+    /**
+     * @brief position of a cell along the cycle, 0 at the top left corner
+     *
+     * @param x column (1-SNAKE_WIDTH)
+     * @param y row (1-SNAKE_HEIGHT)
+     */
+    static uint16_t order(int x, int y);
+
+private:
+    // 2 bits per cell: 0 up, 1 right, 2 down, 3 left
+    uint8_t _dirs[(SNAKE_CELLS + 3) / 4];
+};
+
+#endif /* !HAMILTONIAN_H_ */
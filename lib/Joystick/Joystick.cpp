@@ -1,16 +1,14 @@
 #include "Joystick.h"
 
 Joystick::Joystick(PinName vertPin,PinName horizPin,PinName clickPin)
+    : vert(vertPin), horiz(horizPin), click(clickPin)
 {
-    vert = new AnalogIn(vertPin);
-    horiz = new AnalogIn(horizPin);
-    click = new InterruptIn(clickPin);
 }
 void Joystick::init()
 {
     // read centred values of joystick
-    _x0 = horiz->read();
-    _y0 = vert->read();
+    _x0 = horiz.read();
+    _y0 = vert.read();
 
     // this assumes that the joystick is centred when the init function is called
     // if perfectly centred, the pots should read 0.5, but this may
@@ -18,9 +16,9 @@ void Joystick::init()
 
     // turn on pull-down for button -> this assumes the other side of the button
     // is connected to +3V3 so we read 1 when pressed and 0 when not pressed
-    click->mode(PullUp);
+    click.mode(PullUp);
     // we therefore need to fire the interrupt on a rising edge
-    click->rise(callback(this,&Joystick::click_isr));
+    click.rise(callback(this,&Joystick::click_isr));
     // need to use a callback since mbed-os5 - basically tells it to look in this class for the ISR
     _click_flag = 0;
 
@@ -81,8 +79,8 @@ Vector2D Joystick::get_coord()
 {
     // read() returns value in range 0.0 to 1.0 so is scaled and centre value
     // substracted to get values in the range -1.0 to 1.0
-    float x = 2.0f*( horiz->read() - _x0 );
-    float y = 2.0f*( vert->read() - _y0 );
+    float x = 2.0f*( horiz.read() - _x0 );
+    float y = 2.0f*( vert.read() - _y0 );
 
     // Note: the x value here is inverted to ensure the positive x is to the
     // right. This is simply due to how the potentiometer on the joystick
@@ -92,9 +92,9 @@ public:
     
 private:
 
-    AnalogIn *vert;
-    AnalogIn *horiz;
-    InterruptIn *click;
+    AnalogIn vert;
+    AnalogIn horiz;
+    InterruptIn click;
     
     int _click_flag;    // flag set in ISR
     void click_isr();   // ISR on button press
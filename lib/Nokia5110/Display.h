@@ -0,0 +1,87 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "Raster.h"
+
+/**
+ * @brief A panel and its screen buffer
+ * @details Raster draws into the buffer and the Panel sends it; the panel is
+ * a compile-time policy, so every call is resolved at compile time and there
+ * are no virtual functions. A Panel provides:
+ *
+ *  - `WIDTH` and `HEIGHT`, its size in pixels
+ *  - `Pin`, the type of its pins, and a constructor taking 5 of them (chip
+ *    select, reset, D/C, MOSI, SCLK); Display itself does not need mbed
+ *  - `uint16_t flush(buffer, x0, x1, bank0, bank1)`, which sends a box of the
+ *    buffer with whatever partial update the controller has and returns the
+ *    bytes sent
+ *
+ * Its own calls (init(), set_contrast(), set_power()...) are inherited as
+ * they are. See PCD8544 and SSD1306.
+ */
+template <class Panel>
+class Display : public Raster, public Panel {
+public:
+    typedef RasterLayer<Panel::WIDTH, Panel::HEIGHT> Layer;
+    typedef typename Panel::Pin Pin;
+
+    /**
+     * @brief constructor
+     *
+     * @param sce Chip Enable pin
+     * @param rst Reset pin
+     * @param dc D/C pin
+     * @param dn data pin (MOSI)
+     * @param sclk clock pin (SCLK)
+     */
+    Display(Pin sce, Pin rst, Pin dc, Pin dn, Pin sclk)
+        : Raster(_storage.words, Panel::WIDTH, Panel::HEIGHT), Panel(sce, rst, dc, dn, sclk) {}
+
+    /**
+     * @brief sends the part of the screen buffer that changed since the last
+     * call
+     *
+     * @return bytes sent, 0 if nothing changed
+     */
+    uint16_t display() {
+        uint8_t x0, x1, bank0, bank1;
+        if (!dirty(x0, x1, bank0, bank1)) {
+            return 0;
+        }
+
+        mark_clean();
+        return Panel::flush(_storage.bytes, x0, x1, bank0, bank1);
+    }
+
+    /**
+     * @brief sends the whole screen buffer, e.g. after the panel lost its
+     * memory
+     *
+     * @return bytes sent
+     */
+    uint16_t fastdisplay() {
+        mark_clean();
+        return Panel::flush(_storage.bytes, 0, Panel::WIDTH - 1, 0, Layer::banks - 1);
+    }
+
+private:
+    Layer _storage;
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+
+#include "DisplayList.h"
+
+DisplayList::DisplayList() : _count(0) {}
+
+void DisplayList::clear() {
+    _count = 0;
+}
+
+bool DisplayList::pixel(int16_t x, int16_t y, bool value, Raster::Mode mode) {
+    return add(op_pixel, x, y, value, 0, NULL, mode);
+}
+
+bool DisplayList::line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Raster::Mode mode) {
+    return add(op_line, x0, y0, x1, y1, pattern, mode);
+}
+
+bool DisplayList::hline(int16_t x0, int16_t x1, int16_t y, const pattern_t pattern, Raster::Mode mode) {
+    return add(op_hline, x0, y, x1, y, pattern, mode);
+}
+
+bool DisplayList::vline(int16_t y0, int16_t y1, int16_t x, const pattern_t pattern, Raster::Mode mode) {
+    return add(op_vline, x, y0, x, y1, pattern, mode);
+}
+
+bool DisplayList::rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Raster::Mode mode) {
+    return add(op_rect, x0, y0, x1, y1, pattern, mode);
+}
+
+bool DisplayList::fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Raster::Mode mode) {
+    return add(op_fill_rect, x0, y0, x1, y1, pattern, mode);
+}
+
+bool DisplayList::text(const char *str, int16_t x, int16_t y, Raster::Mode mode) {
+    return add(op_text, x, y, 0, 0, str, mode);
+}
+
+bool DisplayList::text(const char *str, int16_t x, int16_t y, const Font &font, Raster::Mode mode) {
+    if (!add(op_text, x, y, 0, 0, str, mode)) {
+        return false;
+    }
+
+    _cmds[_count - 1].font = &font;
+    return true;
+}
+
+bool DisplayList::bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Raster::Mode mode) {
+    return add(op_bitmap, x, y, width, height, bmp, mode);
+}
+
+void DisplayList::replay(Raster &lcd) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        const dl_cmd &c = _cmds[i];
+        Raster::Mode mode = (Raster::Mode) c.mode;
+        const uint8_t *bytes = (const uint8_t *) c.data;
+
+        switch (c.op) {
+            case op_pixel:
+                lcd.draw_pixel(c.x0, c.y0, (bool) c.x1, mode);
+                break;
+            case op_line:
+                lcd.draw_line(c.x0, c.y0, c.x1, c.y1, bytes, mode);
+                break;
+            case op_hline:
+                lcd.draw_hline(c.x0, c.x1, c.y0, bytes, mode);
+                break;
+            case op_vline:
+                lcd.draw_vline(c.y0, c.y1, c.x0, bytes, mode);
+                break;
+            case op_rect:
+                lcd.draw_rect(c.x0, c.y0, c.x1, c.y1, bytes, mode);
+                break;
+            case op_fill_rect:
+                lcd.fill_rect(c.x0, c.y0, c.x1, c.y1, bytes, mode);
+                break;
+            case op_text:
+                if (c.font) {
+                    lcd.print_string((const char *) c.data, c.x0, c.y0, *c.font, mode);
+                } else {
+                    lcd.print_string((const char *) c.data, c.x0, c.y0, -1, mode);
+                }
+                break;
+            case op_bitmap:
+                lcd.blit_bitmap(bytes, c.x0, c.y0, c.x1, c.y1, mode);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void DisplayList::bake(Raster &lcd, uint32_t *layer) const {
+    lcd.clear_buffer();
+    replay(lcd);
+    lcd.save_buffer(layer);
+}
+
+bool DisplayList::add(uint8_t op, int16_t x0, int16_t y0, int16_t x1, int16_t y1, const void *data, Raster::Mode mode) {
+    if (_count >= DISPLAY_LIST_SIZE) {
+        return false;
+    }
+
+    dl_cmd &c = _cmds[_count++];
+    c.op = op;
+    c.mode = mode;
+    c.x0 = x0;
+    c.y0 = y0;
+    c.x1 = x1;
+    c.y1 = y1;
+    c.data = data;
+    c.font = NULL;
+    return true;
+}
@@ -0,0 +1,166 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include "Raster.h"
+
+// commands per list
+#define DISPLAY_LIST_SIZE 16
+
+/**
+ * @brief One recorded draw call
+ * @details `data` points at the pattern, string or bitmap of the call, which
+ * is not copied and must outlive the list (flash constants and string
+ * literals are fine).
+ */
+struct dl_cmd {
+    uint8_t op;
+    uint8_t mode;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    const void *data;
+    const Font *font; // text only, NULL for the fixed 5x8 font
+};
+
+/**
+ * @brief A recorded list of draw calls for a screen buffer
+ * @details Commands are stored instead of drawn, then rasterized together by
+ * replay(). Screens that never change, like the game border or labels, can
+ * be rasterized once with bake() into a cached layer; each frame then starts
+ * from Raster::load_buffer() of that layer, one pass over the words, and only the
+ * per-frame content is drawn on top.
+ */
+class DisplayList {
+public:
+    enum Op {
+        op_pixel,
+        op_line,
+        op_hline,
+        op_vline,
+        op_rect,
+        op_fill_rect,
+        op_text,
+        op_bitmap
+    };
+
+    DisplayList();
+
+    /**
+     * @brief removes all commands
+     */
+    void clear();
+
+    /**
+     * @brief record the matching Raster draw calls
+     *
+     * @return false if the list is full
+     */
+    bool pixel(int16_t x, int16_t y, bool value = true, Raster::Mode mode = Raster::pixel_copy);
+
+    bool line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+              const pattern_t pattern = Raster::pattern_black,
+              Raster::Mode mode = Raster::pixel_copy);
+
+    bool hline(int16_t x0, int16_t x1, int16_t y,
+               const pattern_t pattern = Raster::pattern_black,
+               Raster::Mode mode = Raster::pixel_copy);
+
+    bool vline(int16_t y0, int16_t y1, int16_t x,
+               const pattern_t pattern = Raster::pattern_black,
+               Raster::Mode mode = Raster::pixel_copy);
+
+    bool rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+              const pattern_t pattern = Raster::pattern_black,
+              Raster::Mode mode = Raster::pixel_copy);
+
+    bool fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                   const pattern_t pattern = Raster::pattern_black,
+                   Raster::Mode mode = Raster::pixel_copy);
+
+    /**
+     * @brief records a string, see Raster::print_string
+     *
+     * @param str string to print, not copied
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param mode  draw mode
+     *
+     * @return false if the list is full
+     */
+    bool text(const char *str, int16_t x, int16_t y, Raster::Mode mode = Raster::pixel_copy);
+
+    /**
+     * @brief records a string in the given font, see Raster::print_string
+     *
+     * @param str string to print, not copied
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param font font to use, not copied
+     * @param mode  draw mode
+     *
+     * @return false if the list is full
+     */
+    bool text(const char *str, int16_t x, int16_t y, const Font &font, Raster::Mode mode = Raster::pixel_copy);
+
+    /**
+     * @brief records a native layout bitmap, see Raster::blit_bitmap
+     *
+     * @param bmp bitmap, not copied
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param width bitmap width in pixels
+     * @param height bitmap height in pixels
+     * @param mode  draw mode
+     *
+     * @return false if the list is full
+     */
+    bool bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                Raster::Mode mode = Raster::pixel_copy);
+
+    /**
+     * @brief draws every command, in order, into the screen buffer
+     *
+     * @param lcd display to draw into
+     */
+    void replay(Raster &lcd) const;
+
+    /**
+     * @brief rasterizes the list on a clear buffer and saves the result
+     * @details Overwrites the screen buffer of `lcd`.
+     *
+     * @param lcd display used to rasterize
+     * @param layer bytes() / 4 words receiving the image
+     */
+    void bake(Raster &lcd, uint32_t *layer) const;
+
+    // the same for a layer, see RasterLayer
+    template <class L> void bake(Raster &lcd, L &layer) const { bake(lcd, layer.words); }
+
+    uint8_t size() const { return _count; }
+
+private:
+    bool add(uint8_t op, int16_t x0, int16_t y0, int16_t x1, int16_t y1, const void *data, Raster::Mode mode);
+
+    dl_cmd _cmds[DISPLAY_LIST_SIZE];
+    uint8_t _count;
+};
+
+#endif
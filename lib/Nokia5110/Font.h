@@ -0,0 +1,84 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// columns stored for every glyph
+#define FONT_GLYPH_COLUMNS 5
+#define FONT_HEIGHT 8
+
+/**
+ * @brief A bitmap font for Raster::print_string
+ * @details Glyphs are FONT_GLYPH_COLUMNS column bytes each, in the display's
+ * native layout (least significant bit on top). Proportional fonts add one
+ * metrics byte per glyph, precomputed so nothing is measured while drawing:
+ * the first column worth drawing in the high nibble and the number of
+ * columns in the low nibble. `scale` 2 draws every pixel as 2x2.
+ */
+struct Font {
+    const uint8_t *glyphs;  // FONT_GLYPH_COLUMNS bytes per character
+    const uint8_t *metrics; // first column << 4 | width, NULL for fixed width
+    uint8_t first;          // first character in the table
+    uint8_t count;          // characters in the table
+    uint8_t spacing;        // blank columns after each glyph, before scaling
+    uint8_t scale;          // 1 or 2
+};
+
+// the original 5x8 font, 6 pixel advance
+extern const Font font_fixed;
+// the same glyphs with their empty columns trimmed
+extern const Font font_small;
+// font_small at double size, 16 pixels high
+extern const Font font_large;
+
+extern const uint8_t font_5x8_glyphs[FONT_GLYPH_COLUMNS * 96];
+
+/**
+ * @brief finds a glyph
+ *
+ * @param font font to use
+ * @param c character
+ * @param width set to the glyph width in columns, before scaling
+ *
+ * @return first column byte to draw, NULL if the font has no such character
+ */
+const uint8_t *font_glyph(const Font &font, char c, uint8_t &width);
+
+/**
+ * @brief how far a character moves the cursor
+ *
+ * @param font font to use
+ * @param c character
+ *
+ * @return advance in pixels, 0 if the font has no such character
+ */
+uint8_t font_advance(const Font &font, char c);
+
+/**
+ * @brief width of a string without drawing it
+ *
+ * @param str string to measure
+ * @param font font to use
+ *
+ * @return width in pixels, without the spacing after the last glyph
+ */
+uint16_t measure_string(const char *str, const Font &font);
+
+#endif
@@ -0,0 +1,90 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#include <string.h>
+#include "NumberField.h"
+
+NumberField::NumberField(Raster &lcd, int16_t x, int16_t y, uint8_t digits, const Font &font, Raster::Mode mode)
+    : _lcd(lcd), _font(font), _x(x), _y(y), _mode(mode), _value(0) {
+    if (digits < 1) {
+        digits = 1;
+    } else if (digits > NUMBER_FIELD_MAX_DIGITS) {
+        digits = NUMBER_FIELD_MAX_DIGITS;
+    }
+    _digits = digits;
+
+    _slot = 0;
+    for (char c = '0'; c <= '9'; c++) {
+        uint8_t advance = font_advance(font, c);
+        if (advance > _slot) {
+            _slot = advance;
+        }
+    }
+
+    invalidate();
+}
+
+uint8_t NumberField::set(uint32_t value) {
+    _value = value;
+
+    // largest value that fits, 10 digits always fit
+    uint32_t limit = 0xFFFFFFFF;
+    if (_digits < NUMBER_FIELD_MAX_DIGITS) {
+        limit = 1;
+        for (uint8_t i = 0; i < _digits; i++) {
+            limit *= 10;
+        }
+        limit--;
+    }
+    if (value > limit) {
+        value = limit;
+    }
+
+    // right to left, blanks once the number runs out
+    char text[NUMBER_FIELD_MAX_DIGITS];
+    for (int8_t i = _digits - 1; i >= 0; i--) {
+        if (value || i == _digits - 1) {
+            text[i] = '0' + value % 10;
+            value /= 10;
+        } else {
+            text[i] = ' ';
+        }
+    }
+
+    uint8_t height = FONT_HEIGHT * _font.scale;
+    Raster::Mode mode = (Raster::Mode) _mode;
+    // background of the slot: white, or black for inverted digits
+    Raster::Mode blank = (_mode & Raster::pixel_invt) ? Raster::pixel_or : Raster::pixel_clr;
+
+    uint8_t drawn = 0;
+    for (uint8_t i = 0; i < _digits; i++) {
+        if (text[i] == _shown[i]) {
+            continue;
+        }
+
+        int16_t x = _x + (int16_t) i * _slot;
+        _lcd.fill_rect(x, _y, x + _slot - 1, _y + height - 1, Raster::pattern_black, blank);
+        _lcd.print_char(text[i], x, _y, _font, mode);
+        _shown[i] = text[i];
+        drawn++;
+    }
+
+    return drawn;
+}
+
+void NumberField::invalidate() {
+    memset(_shown, 0, sizeof(_shown));
+}
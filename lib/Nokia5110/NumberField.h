@@ -0,0 +1,87 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef NUMBERFIELD_H
+#define NUMBERFIELD_H
+
+#include "Raster.h"
+
+// digits in a uint32_t
+#define NUMBER_FIELD_MAX_DIGITS 10
+
+/**
+ * @brief An unsigned number drawn right aligned into a screen buffer
+ * @details Every digit has a slot as wide as the widest digit of the font, so
+ * a digit can be redrawn without touching its neighbours. The field keeps the
+ * characters it last drew and set() only redraws the slots that changed:
+ * counting up by one usually costs a single glyph. Numbers are formatted by
+ * repeated division, without printf.
+ *
+ * If the buffer is cleared or reloaded under the field, call invalidate() so
+ * the next set() draws every slot.
+ */
+class NumberField {
+public:
+    /**
+     * @brief constructor, nothing is drawn until set()
+     *
+     * @param lcd display whose buffer is drawn into
+     * @param x x coordinate of upper left of the first slot
+     * @param y y coordinate of upper left
+     * @param digits number of slots (1-NUMBER_FIELD_MAX_DIGITS)
+     * @param font font to use
+     * @param mode  draw mode of the digits
+     */
+    NumberField(Raster &lcd, int16_t x, int16_t y, uint8_t digits,
+                const Font &font = font_fixed, Raster::Mode mode = Raster::pixel_copy);
+
+    /**
+     * @brief shows a value, redrawing only the digits that changed
+     * @details Values too long for the field show as all nines.
+     *
+     * @param value value to show
+     *
+     * @return number of slots drawn
+     */
+    uint8_t set(uint32_t value);
+
+    /**
+     * @brief forgets what is on screen, e.g. after the buffer was reloaded
+     */
+    void invalidate();
+
+    uint32_t value() const { return _value; }
+
+    /**
+     * @brief width of the field in pixels
+     */
+    int16_t width() const { return (int16_t) _digits * _slot; }
+
+private:
+    Raster &_lcd;
+    const Font &_font;
+    int16_t _x;
+    int16_t _y;
+    uint8_t _digits;
+    uint8_t _slot;
+    uint8_t _mode;
+    uint32_t _value;
+
+    // characters on screen, 0 when unknown
+    char _shown[NUMBER_FIELD_MAX_DIGITS];
+};
+
+#endif
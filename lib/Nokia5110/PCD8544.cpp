@@ -0,0 +1,162 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#include "PCD8544.h"
+
+PCD8544::PCD8544(PinName sce, PinName rst, PinName dc, PinName dn, PinName sclk)
+    : _lcd_SPI(dn, NC, sclk), _sce(sce, 1), _rst(rst, 1), _dc(dc, 0) {
+    _lcd_SPI.format(LCD_SPI_BITS, LCD_SPI_MODE);
+    _lcd_SPI.frequency(LCD_SPI_FREQ);
+}
+
+void PCD8544::init(uint8_t con, uint8_t bias) {
+    if (con > 0x7f) {
+        con = 0x7f;
+    }
+    if (bias > 0x08) {
+        bias = 0x08;
+    }
+
+    reset();
+
+    // the display takes commands right after reset, no settling time needed
+    const uint8_t cmds[] = {
+        LCD_FUNCTIONSET | LCD_EXTENDEDINSTRUCTION,
+        (uint8_t) (LCD_SETVOP | con),
+        (uint8_t) (LCD_SETBIAS | bias),
+        LCD_FUNCTIONSET,
+        LCD_DISPLAYCONTROL | LCD_DISPLAYNORMAL
+    };
+    send_commands(cmds, sizeof(cmds));
+}
+
+void PCD8544::reset() {
+    _rst.write(0);
+    wait_us(LCD_RESET_US);
+    _rst.write(1);
+}
+
+void PCD8544::send_command(uint8_t cmd) {
+    _sce.write(0);
+
+    _lcd_SPI.write(cmd);
+
+    _sce.write(1);
+}
+
+void PCD8544::send_data(uint8_t data) {
+    _dc.write(1);
+    _sce.write(0);
+
+    _lcd_SPI.write(data);
+
+    _sce.write(1);
+    _dc.write(0);
+}
+
+void PCD8544::send_commands(const uint8_t *cmds, uint8_t len) {
+    _sce.write(0);
+
+    for (uint8_t i = 0; i < len; i++) {
+        _lcd_SPI.write(cmds[i]);
+    }
+
+    _sce.write(1);
+}
+
+void PCD8544::set_contrast(uint8_t con) {
+    if (con > 0x7f) {
+        con = 0x7f;
+    }
+
+    const uint8_t cmds[] = {
+        LCD_FUNCTIONSET | LCD_EXTENDEDINSTRUCTION,
+        (uint8_t) (LCD_SETVOP | con),
+        LCD_FUNCTIONSET
+    };
+    send_commands(cmds, sizeof(cmds));
+}
+
+void PCD8544::set_bias(uint8_t bias) {
+    if (bias > 0x08) {
+        bias = 0x08;
+    }
+
+    const uint8_t cmds[] = {
+        LCD_FUNCTIONSET | LCD_EXTENDEDINSTRUCTION,
+        (uint8_t) (LCD_SETBIAS | bias),
+        LCD_FUNCTIONSET
+    };
+    send_commands(cmds, sizeof(cmds));
+}
+
+void PCD8544::set_mode(uint8_t mode) {
+    if (mode > 0x08) {
+        mode = 0x08;
+    }
+
+    send_command(LCD_DISPLAYCONTROL | mode);
+}
+
+void PCD8544::set_power(uint8_t pow) {
+    pow = pow ? 0 : LCD_POWERDOWN;
+    send_command(LCD_FUNCTIONSET | pow);
+}
+
+void PCD8544::set_column(uint8_t col) {
+    col %= LCD_WIDTH;
+    send_command(LCD_SETXADDR | col);
+}
+
+void PCD8544::set_bank(uint8_t bank) {
+    bank %= LCD_BANKS;
+    send_command(LCD_SETYADDR | bank);
+}
+
+void PCD8544::set_cursor(uint8_t col, uint8_t bank) {
+    set_column(col);
+    set_bank(bank);
+}
+
+void PCD8544::send_block(const uint8_t *data, uint16_t len) {
+    _dc.write(1);
+    _sce.write(0);
+    for (uint16_t i = 0; i < len; i++) {
+        _lcd_SPI.write(data[i]);
+    }
+    _sce.write(1);
+    _dc.write(0);
+}
+
+uint16_t PCD8544::flush(const uint8_t *buffer, uint8_t x0, uint8_t x1, uint8_t bank0, uint8_t bank1) {
+    if (x0 == 0 && x1 == LCD_WIDTH - 1) {
+        // whole rows: the pointer wraps from one bank to the next
+        const uint8_t home[] = { (uint8_t) (LCD_SETYADDR | bank0), LCD_SETXADDR };
+        uint16_t len = (bank1 - bank0 + 1) * LCD_WIDTH;
+        send_commands(home, sizeof(home));
+        send_block(&buffer[bank0 * LCD_WIDTH], len);
+        return sizeof(home) + len;
+    }
+
+    uint16_t sent = 0;
+    for (uint8_t bank = bank0; bank <= bank1; bank++) {
+        const uint8_t cursor[] = { (uint8_t) (LCD_SETYADDR | bank), (uint8_t) (LCD_SETXADDR | x0) };
+        send_commands(cursor, sizeof(cursor));
+        send_block(&buffer[x0 + bank * LCD_WIDTH], x1 - x0 + 1);
+        sent += sizeof(cursor) + x1 - x0 + 1;
+    }
+    return sent;
+}
@@ -0,0 +1,224 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef PCD8544_H
+#define PCD8544_H
+
+#include <mbed.h>
+
+// 4MHz clock frequency, maximum of the display
+#define LCD_SPI_FREQ 4000000
+
+// 8 bits per command/data
+#define LCD_SPI_BITS 0x08
+
+// Polarity 0 Phase 0, may be different on your platform
+/*
+ mode | POL PHA
+ -----+--------
+   0  |  0   0
+   1  |  0   1
+   2  |  1   0
+   3  |  1   1
+*/
+#define LCD_SPI_MODE 0x00
+
+// reset pulse, the datasheet asks for 100ns minimum
+#define LCD_RESET_US 1
+
+#define LCD_WIDTH 84
+#define LCD_HEIGHT 48
+#define LCD_BANKS 6
+#define LCD_BYTES 504
+#define LCD_WORDS (LCD_BYTES / 4)
+
+#define LCD_POWERDOWN 0x04
+#define LCD_ENTRYMODE 0x02
+#define LCD_EXTENDEDINSTRUCTION 0x01
+
+#define LCD_DISPLAYBLANK 0x0
+#define LCD_DISPLAYNORMAL 0x4
+#define LCD_DISPLAYALLON 0x1
+#define LCD_DISPLAYINVERTED 0x5
+
+// basic instruction set
+#define LCD_FUNCTIONSET 0x20
+#define LCD_DISPLAYCONTROL 0x08
+#define LCD_SETYADDR 0x40
+#define LCD_SETXADDR 0x80
+
+// extended instruction set
+#define LCD_SETTEMP 0x04
+#define LCD_SETBIAS 0x10
+#define LCD_SETVOP 0x80
+
+/**
+ * @brief The PCD8544 controller of the Nokia 5110 display, over SPI
+ * @details The Nokia 5110 display is a 84x48 pixel single-bit LCD using the
+ * PCD8544 controller.
+ *  It is controlled by a modified version of the SPI protox.
+ *
+ *  If the API or test files dont work at first, try changing the contrast
+ * setting. Different units
+ *   will work best at different values. I've had this value range from 40 to 80
+ *
+ * This is only the transport; drawing is done by Raster and the two are put
+ * together by Display (see Nokia5110.h).
+ */
+class PCD8544 {
+public:
+    enum {
+        WIDTH = LCD_WIDTH,
+        HEIGHT = LCD_HEIGHT
+    };
+
+    typedef PinName Pin;
+
+    /**
+     * @brief constructor
+     *
+     * @param sce Chip Enable pin
+     * @param rst Reset pin
+     * @param dc D/C pin
+     * @param dn data pin (MOSI)
+     * @param sclk clock pin (SCLK)
+     */
+    PCD8544(PinName sce, PinName rst, PinName dc, PinName dn, PinName sclk);
+
+    /**
+     * @brief initialize the display with given contrast and bias.
+     * @details Takes a few microseconds: a minimum length reset pulse, then
+     * every setting in one transfer.
+     *
+     * @param con contrast for the display
+     * @param bias bias for the display, should be 0x04 for the nokia 5110
+     * display. only change for other PCD8544 displays
+     */
+    void init(uint8_t con = 40, uint8_t bias = 0x04);
+
+    /**
+     * @brief reset the display's memory
+     */
+    void reset();
+
+    /**
+     * @brief send a command to the display
+     *
+     * @param cmd command to send
+     */
+    void send_command(uint8_t cmd);
+
+    /**
+     * @brief send a byte of data to the display
+     *
+     * @param data data to send
+     */
+    void send_data(uint8_t data);
+
+    /**
+     * @brief send several commands in a single transfer
+     *
+     * @param cmds commands to send
+     * @param len number of commands
+     */
+    void send_commands(const uint8_t *cmds, uint8_t len);
+
+    /**
+     * @brief sets the display's contrast
+     *
+     * @param con contrast, usually between 40 and 60 depending on your
+     * display
+     */
+    void set_contrast(uint8_t con);
+
+    /**
+     * @brief sets the dispay's bias
+     *
+     * @param bias bias, should be 0x4 for the Nokia 5110 display
+     */
+    void set_bias(uint8_t bias);
+
+    /**
+     * @brief sets the display's display mode
+     *
+     * @param mode display mode (Blank, inverted, allon or normal)
+     */
+    void set_mode(uint8_t mode);
+
+    /**
+     * @brief turns the display on or off
+     *
+     * @param pow power, 0 = off, 1 = on
+     */
+    void set_power(uint8_t pow);
+
+    /**
+     * @brief sets the X value of the cursor
+     *
+     * @param col x coordinate (0-83)
+     */
+    void set_column(uint8_t col);
+
+    /**
+     * @brief sets the Y value of the cursor
+     *
+     * @param bank memory bank (0-5)
+     */
+    void set_bank(uint8_t bank);
+
+    /**
+     * @brief sets the X and Y values of the cursor
+     *
+     * @param col x coordinate (0-83)
+     * @param bank memory bank (0-5)
+     */
+    void set_cursor(uint8_t col, uint8_t bank);
+
+    /**
+     * @brief sends part of a screen buffer to the display
+     * @details The controller only has a write pointer that moves right and
+     * wraps to the next bank, so a box as wide as the screen goes out as one
+     * transfer and a narrower one as one transfer per bank, each after a
+     * cursor move.
+     *
+     * @param buffer screen buffer in the bank layout, LCD_WIDTH bytes per bank
+     * @param x0 first column
+     * @param x1 last column
+     * @param bank0 first bank
+     * @param bank1 last bank
+     *
+     * @return bytes sent, commands included
+     */
+    uint16_t flush(const uint8_t *buffer, uint8_t x0, uint8_t x1, uint8_t bank0, uint8_t bank1);
+
+private:
+    /**
+     * @brief sends buffer bytes in one transfer
+     *
+     * @param data bytes to send
+     * @param len number of bytes
+     */
+    void send_block(const uint8_t *data, uint16_t len);
+
+    // drivers live inside the object, nothing is allocated at run time
+    SPI _lcd_SPI;
+
+    DigitalOut _sce;
+    DigitalOut _rst;
+    DigitalOut _dc;
+};
+
+#endif
@@ -0,0 +1,993 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Raster.h"
+
+// copies a byte into the 4 byte lanes of a word
+#define LANES(b) ((uint32_t) (uint8_t) (b) * 0x01010101UL)
+
+Raster::Raster(uint32_t *buffer, uint8_t width, uint8_t height)
+    : _buffer((uint8_t *) buffer), _words(buffer), _width(width), _height(height) {
+    _banks = height / 8;
+    _row_words = width / 4;
+    _bytes = width * _banks;
+    _word_count = _bytes / 4;
+
+    reset_clip();
+    mark_dirty();
+}
+
+bool Raster::dirty(uint8_t &x0, uint8_t &x1, uint8_t &bank0, uint8_t &bank1) const {
+    if (_dirty_x0 > _dirty_x1) {
+        return false;
+    }
+
+    x0 = _dirty_x0;
+    x1 = _dirty_x1;
+    bank0 = _dirty_b0;
+    bank1 = _dirty_b1;
+    return true;
+}
+
+void Raster::mark_clean() {
+    _dirty_x0 = _width;
+    _dirty_x1 = -1;
+    _dirty_b0 = _banks;
+    _dirty_b1 = -1;
+}
+
+void Raster::mark_dirty() {
+    _dirty_x0 = 0;
+    _dirty_x1 = _width - 1;
+    _dirty_b0 = 0;
+    _dirty_b1 = _banks - 1;
+}
+
+void Raster::set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (x0 > x1) {
+        int16_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+
+    if (y0 > y1) {
+        int16_t tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+
+    _clip_x0 = (x0 < 0) ? 0 : x0;
+    _clip_y0 = (y0 < 0) ? 0 : y0;
+    _clip_x1 = (x1 >= _width) ? _width - 1 : x1;
+    _clip_y1 = (y1 >= _height) ? _height - 1 : y1;
+
+    if (_clip_x0 > _clip_x1 || _clip_y0 > _clip_y1) {
+        // nothing left on screen: an empty rectangle every check rejects
+        _clip_x0 = 0;
+        _clip_y0 = 0;
+        _clip_x1 = -1;
+        _clip_y1 = -1;
+    }
+}
+
+void Raster::reset_clip() {
+    set_clip(0, 0, _width - 1, _height - 1);
+}
+
+void Raster::clear_buffer() {
+    mark_dirty();
+    for (unsigned int i = 0; i < _word_count; i++) {
+        _words[i] = 0;
+    }
+}
+
+void Raster::fill_buffer(const pattern_t pattern) {
+    // turn the 8 pattern rows into 8 column bytes, as they sit in a bank
+    uint8_t cols[8];
+    for (uint8_t c = 0; c < 8; c++) {
+        cols[c] = 0;
+        for (uint8_t r = 0; r < 8; r++) {
+            if (pattern[r] & (1 << c)) {
+                cols[c] |= 1 << r;
+            }
+        }
+    }
+
+    // every bank starts at x = 0, so they are all the same
+    mark_dirty();
+    for (uint8_t x = 0; x < _width; x++) {
+        _buffer[x] = cols[x % 8];
+    }
+    for (unsigned int i = _row_words; i < _word_count; i++) {
+        _words[i] = _words[i - _row_words];
+    }
+}
+
+void Raster::invert_buffer() {
+    mark_dirty();
+    for (unsigned int i = 0; i < _word_count; i++) {
+        _words[i] = ~_words[i];
+    }
+}
+
+void Raster::scroll_horiz(int8_t dx) {
+    uint8_t n = (dx < 0) ? -dx : dx;
+    if (n >= _width) {
+        clear_buffer();
+        return;
+    }
+
+    mark_dirty();
+    for (uint8_t bank = 0; bank < _banks; bank++) {
+        uint8_t *row = &_buffer[bank * _width];
+        if (dx > 0) {
+            memmove(row + n, row, _width - n);
+            memset(row, 0, n);
+        } else {
+            memmove(row, row + n, _width - n);
+            memset(row + _width - n, 0, n);
+        }
+    }
+}
+
+void Raster::scroll_vert(int8_t dy) {
+    uint8_t n = (dy < 0) ? -dy : dy;
+    if (n >= _height) {
+        clear_buffer();
+        return;
+    }
+
+    int8_t banks = n / 8;
+    uint8_t shift = n % 8;
+    mark_dirty();
+
+    if (dy > 0) {
+        // moving down: bits go up in each byte, carry comes from the bank above
+        uint32_t keep = LANES(0xFF << shift);
+        for (int8_t bank = _banks - 1; bank >= 0; bank--) {
+            int8_t src = bank - banks;
+            uint32_t *dst = &_words[bank * _row_words];
+            for (uint8_t w = 0; w < _row_words; w++) {
+                uint32_t hi = (src >= 0) ? _words[src * _row_words + w] : 0;
+                uint32_t lo = (src >= 1) ? _words[(src - 1) * _row_words + w] : 0;
+                dst[w] = shift ? (((hi << shift) & keep) | ((lo >> (8 - shift)) & ~keep)) : hi;
+            }
+        }
+    } else {
+        // moving up: bits go down in each byte, carry comes from the bank below
+        uint32_t keep = LANES(0xFF >> shift);
+        for (int8_t bank = 0; bank < _banks; bank++) {
+            int8_t src = bank + banks;
+            uint32_t *dst = &_words[bank * _row_words];
+            for (uint8_t w = 0; w < _row_words; w++) {
+                uint32_t lo = (src < _banks) ? _words[src * _row_words + w] : 0;
+                uint32_t hi = (src + 1 < _banks) ? _words[(src + 1) * _row_words + w] : 0;
+                dst[w] = shift ? (((lo >> shift) & keep) | ((hi << (8 - shift)) & ~keep)) : lo;
+            }
+        }
+    }
+}
+
+void Raster::copy_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t dx, int16_t dy, Mode mode) {
+    if (x >= _width || y >= _height) {
+        return;
+    }
+    if (width > _width - x) {
+        width = _width - x;
+    }
+    if (height > _height - y) {
+        height = _height - y;
+    }
+
+    // only the columns that land inside the clip rectangle
+    int32_t c0 = (dx < _clip_x0) ? _clip_x0 - dx : 0;
+    int32_t c1 = (dx + width - 1 > _clip_x1) ? _clip_x1 - dx : width - 1;
+    uint64_t mask = (height >= 64) ? ~(uint64_t) 0 : ((uint64_t) 1 << height) - 1;
+
+    // walk away from the destination so overlapping columns are read first
+    for (int32_t i = c0; i <= c1; i++) {
+        int32_t c = (dx > x) ? c1 - (i - c0) : i;
+
+        // the whole source column as one value, up to 64 bits
+        uint64_t column = 0;
+        for (uint8_t bank = 0; bank < _banks; bank++) {
+            column |= (uint64_t) _buffer[x + c + bank * _width] << (bank * 8);
+        }
+        column = (column >> y) & mask;
+
+        for (uint8_t row = 0; row < height; row += 8) {
+            uint8_t bits = column >> row;
+            uint8_t part = (height - row >= 8) ? 0xFF : (1 << (height - row)) - 1;
+            blit_byte(dx + c, dy + row, bits, part, mode);
+        }
+    }
+}
+
+void Raster::save_buffer(uint32_t *dst) {
+    memcpy(dst, _words, _bytes);
+}
+
+void Raster::load_buffer(const uint32_t *src) {
+    for (uint8_t bank = 0; bank < _banks; bank++) {
+        uint32_t *dst = &_words[bank * _row_words];
+        const uint32_t *row = &src[bank * _row_words];
+        for (uint8_t w = 0; w < _row_words; w++) {
+            if (dst[w] != row[w]) {
+                dst[w] = row[w];
+                touch(w * 4, w * 4 + 3, bank, bank);
+            }
+        }
+    }
+}
+
+// dst = b combined with f; one loop per mode so the inner loop has no branches
+static void combine_words(uint32_t *dst, const uint32_t *b, const uint32_t *f, uint16_t count, Raster::Mode mode) {
+    uint32_t invert = (mode & 0x4) ? 0xFFFFFFFF : 0;
+
+    switch (mode & 0x3) {
+    default:
+    case Raster::pixel_copy:
+        for (unsigned int i = 0; i < count; i++) {
+            dst[i] = f[i] ^ invert;
+        }
+        break;
+    case Raster::pixel_or:
+        for (unsigned int i = 0; i < count; i++) {
+            dst[i] = b[i] | (f[i] ^ invert);
+        }
+        break;
+    case Raster::pixel_xor:
+        for (unsigned int i = 0; i < count; i++) {
+            dst[i] = b[i] ^ (f[i] ^ invert);
+        }
+        break;
+    case Raster::pixel_clr:
+        for (unsigned int i = 0; i < count; i++) {
+            dst[i] = b[i] & ~(f[i] ^ invert);
+        }
+        break;
+    }
+}
+
+void Raster::composite(const uint32_t *layer, Mode mode) {
+    mark_dirty();
+    combine_words(_words, _words, layer, _word_count, mode);
+}
+
+void Raster::composite(const uint32_t *bg, const uint32_t *fg, Mode mode) {
+    mark_dirty();
+    combine_words(_words, bg, fg, _word_count, mode);
+}
+
+void Raster::draw_pixel(int16_t x, int16_t y, const pattern_t pattern, Mode mode) {
+    bool value = pattern[y & 7] & (1 << (x & 7)); // I am going to hell
+    draw_pixel(x, y, value, mode);
+}
+
+void Raster::draw_pixel(int16_t x, int16_t y, bool value, Mode mode) {
+    if (x < _clip_x0 || x > _clip_x1 || y < _clip_y0 || y > _clip_y1) {
+        return;
+    }
+
+    plot(x, y, value, mode);
+}
+
+void Raster::plot(int16_t x, int16_t y, bool value, Mode mode) {
+    if (mode & 0x4) {
+        mode = (Mode) (mode & 0x3);
+        value = !value;
+    }
+
+    if (mode == pixel_copy) {
+        mode = value ? pixel_or : pixel_clr;
+        value = true;
+    }
+
+    if (value) {
+        uint8_t *dst = &_buffer[x + (y >> 3) * _width];
+        uint8_t bit = 1 << (y & 7);
+        touch(x, x, y >> 3, y >> 3);
+
+        switch (mode) {
+        default:
+        case pixel_or:
+            *dst |= bit;
+            break;
+        case pixel_xor:
+            *dst ^= bit;
+            break;
+        case pixel_clr:
+            *dst &= ~bit;
+            break;
+        }
+    }
+}
+
+uint8_t Raster::get_pixel(int16_t x, int16_t y) {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) {
+        return 0;
+    }
+
+    return _buffer[x + (y / 8) * _width] & (1 << (y % 8));
+}
+
+void Raster::draw_byte(uint8_t col, uint8_t bank, uint8_t byte) {
+    if (col >= _width || bank >= _banks) {
+        return;
+    }
+
+    _buffer[col + bank * _width] = byte;
+    touch(col, col, bank, bank);
+}
+
+uint8_t Raster::get_byte(uint8_t col, uint8_t bank) {
+    if (col >= _width || bank >= _banks) {
+        return 0;
+    }
+
+    return _buffer[col + bank * _width];
+}
+
+int16_t Raster::print_char(char c, int16_t x, int16_t y, Mode mode) {
+    return print_char(c, x, y, font_fixed, mode);
+}
+
+int16_t Raster::print_string(const char *str, int16_t x, int16_t y, int8_t chars, Mode mode) {
+    while (*str && x <= _clip_x1 && chars-- != 0) {
+        x = print_char(*str, x, y, mode);
+        str++;
+    }
+
+    return x;
+}
+
+// each bit of a nibble doubled, to scale glyph columns up 2x
+static const uint8_t double_bits[16] = {
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+int16_t Raster::print_char(char c, int16_t x, int16_t y, const Font &font, Mode mode) {
+    uint8_t width;
+    const uint8_t *glyph = font_glyph(font, c, width);
+    if (!glyph) {
+        return x;
+    }
+
+    if (font.scale == 2) {
+        // two rows of doubled columns, in the native layout
+        uint8_t big[2 * 2 * FONT_GLYPH_COLUMNS];
+        uint8_t cols = 2 * width;
+        for (uint8_t i = 0; i < width; i++) {
+            big[2 * i] = big[2 * i + 1] = double_bits[glyph[i] & 0x0F];
+            big[cols + 2 * i] = big[cols + 2 * i + 1] = double_bits[glyph[i] >> 4];
+        }
+        blit_bitmap(big, x, y, cols, 2 * FONT_HEIGHT, mode);
+    } else {
+        blit_bitmap(glyph, x, y, width, FONT_HEIGHT, mode);
+    }
+
+    return x + (width + font.spacing) * font.scale;
+}
+
+int16_t Raster::print_string(const char *str, int16_t x, int16_t y, const Font &font, Mode mode) {
+    while (*str && x <= _clip_x1) {
+        x = print_char(*str, x, y, font, mode);
+        str++;
+    }
+
+    return x;
+}
+
+void Raster::draw_bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode) {
+    uint8_t mask = 0x80;
+
+    for (uint8_t dy = 0; dy < height; dy++) {
+        for (uint8_t dx = 0; dx < width; dx++) {
+            draw_pixel(x + dx, y + dy, *bmp & mask, mode);
+            mask >>= 1;
+
+            if (mask == 0) { // if we reached the end of the byte
+                mask = 0x80;
+                bmp++;
+            }
+        }
+    }
+}
+
+void Raster::draw_wbitmap(const uint8_t *wbmp, int16_t x, int16_t y, Mode mode) {
+    if (*wbmp++ != 0x00) { // image type, only supports 0
+        return;
+    }
+    if (*wbmp++ != 0x00) { // always 0
+        return;
+    }
+    uint8_t width = *wbmp++; // image width in pixels
+    uint8_t height = *wbmp++; // image height in pixels
+
+    uint8_t mask = 0x80;
+
+    for (uint8_t dy = 0; dy < height; dy++) {
+        for (uint8_t dx = 0; dx < width; dx++) {
+            draw_pixel(x + dx, y + dy, *wbmp & mask, mode);
+            mask >>= 1;
+
+            if (mask == 0) { // if we reached the end of the byte
+                mask = 0x80;
+                wbmp++;
+            }
+        }
+        if (mask != 0x80) {
+            mask = 0x80; // wbmps pad out the end of each y, so reset the mask
+            wbmp++;
+        }
+    }
+}
+
+// combines 8 pixels into a buffer byte the same way draw_pixel does one
+static inline uint8_t apply_mode(uint8_t dst, uint8_t src, uint8_t mask, Raster::Mode mode) {
+    if (mode & 0x4) {
+        src = ~src;
+    }
+    src &= mask;
+
+    switch (mode & 0x3) {
+    default:
+    case Raster::pixel_copy:
+        return (dst & ~mask) | src;
+    case Raster::pixel_or:
+        return dst | src;
+    case Raster::pixel_xor:
+        return dst ^ src;
+    case Raster::pixel_clr:
+        return dst & ~src;
+    }
+}
+
+// bank holding row y, rounding down for rows above the screen
+static inline int16_t bank_of(int16_t y) {
+    return (y < 0) ? -((7 - y) / 8) : y / 8;
+}
+
+uint8_t Raster::clip_bank(int16_t bank) {
+    int32_t lo = _clip_y0 - bank * 8;
+    int32_t hi = _clip_y1 - bank * 8;
+    if (hi < 0 || lo > 7) {
+        return 0;
+    }
+
+    uint8_t mask = 0xFF;
+    if (lo > 0) {
+        mask &= 0xFF << lo;
+    }
+    if (hi < 7) {
+        mask &= 0xFF >> (7 - hi);
+    }
+    return mask;
+}
+
+void Raster::blit_byte(int16_t col, int16_t y, uint8_t bits, uint8_t mask, Mode mode) {
+    if (col < _clip_x0 || col > _clip_x1) {
+        return;
+    }
+
+    int16_t bank = bank_of(y);
+    uint8_t shift = y - bank * 8;
+
+    uint8_t m = (mask << shift) & clip_bank(bank);
+    if (m) {
+        uint8_t *dst = &_buffer[col + bank * _width];
+        *dst = apply_mode(*dst, bits << shift, m, mode);
+        touch(col, col, bank, bank);
+    }
+    m = shift ? (mask >> (8 - shift)) & clip_bank(bank + 1) : 0;
+    if (m) {
+        uint8_t *dst = &_buffer[col + (bank + 1) * _width];
+        *dst = apply_mode(*dst, bits >> (8 - shift), m, mode);
+        touch(col, col, bank + 1, bank + 1);
+    }
+}
+
+void Raster::fill_span(int16_t x, int16_t y0, int16_t y1, const pattern_t pattern, Mode mode) {
+    if (y0 > y1) {
+        int16_t tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+    if (x < _clip_x0 || x > _clip_x1 || y1 < _clip_y0 || y0 > _clip_y1) {
+        return;
+    }
+    if (y0 < _clip_y0) {
+        y0 = _clip_y0;
+    }
+    if (y1 > _clip_y1) {
+        y1 = _clip_y1;
+    }
+
+    // the pattern's column for x, as it sits in every bank
+    uint8_t bits = 0;
+    for (uint8_t r = 0; r < 8; r++) {
+        if (pattern[r] & (1 << (x & 7))) {
+            bits |= 1 << r;
+        }
+    }
+
+    uint8_t first = y0 / 8;
+    uint8_t last = y1 / 8;
+    touch(x, x, first, last);
+    for (uint8_t bank = first; bank <= last; bank++) {
+        uint8_t mask = 0xFF;
+        if (bank == first) {
+            mask &= 0xFF << (y0 % 8);
+        }
+        if (bank == last) {
+            mask &= 0xFF >> (7 - y1 % 8);
+        }
+        uint8_t *dst = &_buffer[x + bank * _width];
+        *dst = apply_mode(*dst, bits, mask, mode);
+    }
+}
+
+void Raster::blit_row(int16_t x, int16_t top, uint8_t mask, const uint8_t *src, uint8_t value,
+                         uint8_t from, uint8_t len, Mode mode) {
+    // columns inside the clip rectangle, in 32 bits: x may be far to the left
+    int32_t c0 = (x + from < _clip_x0) ? _clip_x0 - x : from;
+    int32_t c1 = (x + from + len - 1 > _clip_x1) ? _clip_x1 - x : from + len - 1;
+    if (c0 > c1) {
+        return;
+    }
+
+    // the two banks the row straddles, masked to the clip rectangle once
+    int16_t bank = bank_of(top);
+    uint8_t shift = top - bank * 8;
+    uint8_t m0 = (mask << shift) & clip_bank(bank);
+    uint8_t m1 = shift ? (mask >> (8 - shift)) & clip_bank(bank + 1) : 0;
+    if (m0 || m1) {
+        touch(x + c0, x + c1, m0 ? bank : bank + 1, m1 ? bank + 1 : bank);
+    }
+
+    if (mode == pixel_copy && m0 == 0xFF && shift == 0) {
+        // bank aligned: straight copy
+        uint8_t *dst = &_buffer[x + c0 + bank * _width];
+        if (src) {
+            memcpy(dst, src + (c0 - from), c1 - c0 + 1);
+        } else {
+            memset(dst, value, c1 - c0 + 1);
+        }
+        return;
+    }
+    if (m0) {
+        uint8_t *dst = &_buffer[x + c0 + bank * _width];
+        for (int16_t c = c0; c <= c1; c++, dst++) {
+            uint8_t bits = src ? src[c - from] : value;
+            *dst = apply_mode(*dst, bits << shift, m0, mode);
+        }
+    }
+    if (m1) {
+        uint8_t *dst = &_buffer[x + c0 + (bank + 1) * _width];
+        for (int16_t c = c0; c <= c1; c++, dst++) {
+            uint8_t bits = src ? src[c - from] : value;
+            *dst = apply_mode(*dst, bits >> (8 - shift), m1, mode);
+        }
+    }
+}
+
+// rows past the bottom of the bitmap are left alone
+static inline uint8_t row_mask(uint8_t height, uint8_t row) {
+    return (height - row * 8 >= 8) ? 0xFF : (1 << (height - row * 8)) - 1;
+}
+
+void Raster::blit_bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode) {
+    uint8_t rows = (height + 7) / 8;
+    for (uint8_t row = 0; row < rows; row++) {
+        int16_t top = y + row * 8;
+        if (top > _clip_y1) {
+            break;
+        }
+        blit_row(x, top, row_mask(height, row), bmp + row * width, 0, 0, width, mode);
+    }
+}
+
+void Raster::blit_rle(const uint8_t *rle, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode) {
+    if (!width) {
+        return;
+    }
+
+    uint8_t rows = (height + 7) / 8;
+    uint8_t row = 0;
+    uint8_t col = 0;
+
+    if (mode == pixel_copy && y >= _clip_y0 && y % 8 == 0 && height % 8 == 0 && y + height - 1 <= _clip_y1 &&
+        x >= _clip_x0 && x + width - 1 <= _clip_x1) {
+        // whole banks, all visible: blocks go straight to the buffer
+        touch(x, x + width - 1, y / 8, y / 8 + rows - 1);
+        uint8_t *dst = &_buffer[x + (y / 8) * _width];
+        while (row < rows) {
+            uint8_t code = *rle++;
+            bool run = code & LCD_RLE_RUN;
+            uint8_t count = run ? (code & ~LCD_RLE_RUN) + 2 : code + 1;
+            while (count && row < rows) {
+                uint8_t len = (count < width - col) ? count : width - col;
+                if (run) {
+                    memset(dst + col, *rle, len);
+                } else {
+                    memcpy(dst + col, rle, len);
+                    rle += len;
+                }
+                count -= len;
+                col += len;
+                if (col == width) {
+                    col = 0;
+                    row++;
+                    dst += _width;
+                }
+            }
+            if (run) {
+                rle++;
+            }
+        }
+        return;
+    }
+
+    while (row < rows && y + row * 8 <= _clip_y1) {
+        uint8_t code = *rle++;
+        bool run = code & LCD_RLE_RUN;
+        uint8_t count = run ? (code & ~LCD_RLE_RUN) + 2 : code + 1;
+        uint8_t value = run ? *rle++ : 0;
+
+        // a block may go on into the next rows
+        while (count && row < rows) {
+            uint8_t len = (count < width - col) ? count : width - col;
+            blit_row(x, y + row * 8, row_mask(height, row), run ? NULL : rle, value, col, len, mode);
+
+            if (!run) {
+                rle += len;
+            }
+            count -= len;
+            col += len;
+            if (col == width) {
+                col = 0;
+                row++;
+            }
+        }
+    }
+}
+
+// ceiling of n / d, for d > 0
+static inline int64_t ceil_div(int64_t n, int64_t d) {
+    return (n >= 0) ? (n + d - 1) / d : -(-n / d);
+}
+
+void Raster::draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Mode mode) {
+    //use faster algorithms for horizontal and vertical lines
+    if (y0 == y1) {
+        draw_hline(x0, x1, y0, pattern, mode);
+        return;
+    }
+    if (x0 == x1) {
+        draw_vline(y0, y1, x0, pattern, mode);
+        return;
+    }
+
+    // walk the longer axis u one pixel per step; by step i the other axis v
+    // has moved k(i) = (2 * i * minor + major - 1) / (2 * major) pixels
+    bool steep = abs(y1 - y0) >= abs(x1 - x0);
+    int32_t major = steep ? abs(y1 - y0) : abs(x1 - x0);
+    int32_t minor = steep ? abs(x1 - x0) : abs(y1 - y0);
+    int16_t u0 = steep ? y0 : x0;
+    int16_t v0 = steep ? x0 : y0;
+    int8_t su = ((steep ? y1 - y0 : x1 - x0) < 0) ? -1 : 1;
+    int8_t sv = ((steep ? x1 - x0 : y1 - y0) < 0) ? -1 : 1;
+    int16_t ulo = steep ? _clip_y0 : _clip_x0;
+    int16_t uhi = steep ? _clip_y1 : _clip_x1;
+    int16_t vlo = steep ? _clip_x0 : _clip_y0;
+    int16_t vhi = steep ? _clip_x1 : _clip_y1;
+
+    // only the steps inside the clip rectangle are walked, so a clipped line
+    // has exactly the pixels the whole line has there
+    int32_t first = (su > 0) ? ulo - u0 : u0 - uhi;
+    int32_t last = (su > 0) ? uhi - u0 : u0 - ulo;
+    int32_t tlo = (sv > 0) ? vlo - v0 : v0 - vhi;
+    int32_t thi = (sv > 0) ? vhi - v0 : v0 - vlo;
+    int64_t from = ceil_div(2 * (int64_t) major * tlo - major + 1, 2 * (int64_t) minor);
+    int64_t to = ceil_div(2 * (int64_t) major * (thi + 1) - major + 1, 2 * (int64_t) minor) - 1;
+    if (first < from) {
+        first = from;
+    }
+    if (first < 0) {
+        first = 0;
+    }
+    if (last > to) {
+        last = to;
+    }
+    if (last > major) {
+        last = major;
+    }
+    if (first > last) {
+        return;
+    }
+
+    // the error term as it is after `first` steps
+    int32_t k = (2 * (int64_t) first * minor + major - 1) / (2 * major);
+    int32_t d = 2 * minor - major + 2 * ((int64_t) first * minor - (int64_t) major * k);
+    int16_t u = u0 + su * first;
+    int16_t v = v0 + sv * k;
+    for (int32_t i = first; i <= last; i++) {
+        if (steep) {
+            plot(v, u, pattern[u & 7] & (1 << (v & 7)), mode);
+        } else {
+            plot(u, v, pattern[v & 7] & (1 << (u & 7)), mode);
+        }
+        if (d > 0) {
+            v += sv;
+            d -= 2 * major;
+        }
+        d += 2 * minor;
+        u += su;
+    }
+}
+
+void Raster::draw_hline(int16_t x0, int16_t x1, int16_t y, const pattern_t pattern, Mode mode) {
+    if (x0 > x1) {
+        int16_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+    if (y < _clip_y0 || y > _clip_y1 || x1 < _clip_x0 || x0 > _clip_x1) {
+        return;
+    }
+    if (x0 < _clip_x0) {
+        x0 = _clip_x0;
+    }
+    if (x1 > _clip_x1) {
+        x1 = _clip_x1;
+    }
+
+    uint8_t *row = &_buffer[(y / 8) * _width];
+    uint8_t bit = 1 << (y % 8);
+    touch(x0, x1, y / 8, y / 8);
+    uint8_t line = pattern[y % 8];
+    for (int16_t x = x0; x <= x1; x++) {
+        row[x] = apply_mode(row[x], (line & (1 << (x & 7))) ? 0xFF : 0, bit, mode);
+    }
+}
+
+void Raster::draw_vline(int16_t y0, int16_t y1, int16_t x, const pattern_t pattern, Mode mode) {
+    fill_span(x, y0, y1, pattern, mode);
+}
+
+void Raster::draw_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Mode mode) {
+    draw_hline(x0, x1, y0, pattern, mode);
+    draw_hline(x0, x1, y1, pattern, mode);
+    draw_vline(y0, y1, x0, pattern, mode);
+    draw_vline(y0, y1, x1, pattern, mode);
+}
+
+void Raster::fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, const pattern_t pattern, Mode mode) {
+    if (x0 > x1) {
+        int16_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+    if (x0 < _clip_x0) {
+        x0 = _clip_x0;
+    }
+    if (x1 > _clip_x1) {
+        x1 = _clip_x1;
+    }
+
+    for (int16_t x = x0; x <= x1; x++) {
+        fill_span(x, y0, y1, pattern, mode);
+    }
+}
+
+/**
+ * Walks the columns of a quarter ellipse with radii a and b, from the center
+ * outwards. For each column dx it gives the rows lo..hi (above the center)
+ * of the outline, so the whole shape comes out as vertical spans.
+ *
+ * A column's outline is its rounded height b*sqrt(1 - dx^2/a^2) plus every
+ * row whose rounded width a*sqrt(1 - dy^2/b^2) is dx. Using both keeps the
+ * steep and the flat parts of the curve connected. Both are tracked with
+ * midpoint error terms, no square roots or divisions.
+ */
+class QuarterArc {
+public:
+    QuarterArc(uint8_t a, uint8_t b) : _a(a), _b(b), _dx(0), _h(b), _row(b), _w(0), _prev(b + 1) {
+        _a2 = (int32_t) a * a;
+        _b2 = (int32_t) b * b;
+        _herr = _a2 * (4 * b - 1);
+        _werr = -_b2;
+    }
+
+    bool next(uint8_t &dx, uint8_t &lo, uint8_t &hi) {
+        if (_dx > _a) {
+            return false;
+        }
+
+        // rows whose width reaches no further than this column
+        while (_row >= 0 && _w <= _dx) {
+            _row--;
+            if (_row >= 0) {
+                _werr += 4 * _a2 * (2 * _row + 1);
+                while (_werr > 0) {
+                    _w++;
+                    _werr -= 8 * _b2 * _w;
+                }
+            }
+        }
+        int16_t first = _row + 1;
+
+        dx = _dx;
+        lo = _h;
+        hi = _h;
+        if (first < _prev) {
+            lo = (first < _h) ? first : _h;
+            hi = (_prev - 1 > _h) ? _prev - 1 : _h;
+        }
+        _prev = first;
+
+        // height of the next column
+        _herr -= 4 * _b2 * (2 * _dx + 1);
+        _dx++;
+        while (_h > 0 && _herr <= 0) {
+            _herr += 8 * _a2 * (_h - 1);
+            _h--;
+        }
+        return true;
+    }
+
+private:
+    int32_t _a2;
+    int32_t _b2;
+    uint8_t _a;
+    uint8_t _b;
+
+    int16_t _dx;   // next column
+    int16_t _h;    // its height
+    int32_t _herr; // 4b^2(a^2 - dx^2) - a^2(2h - 1)^2, > 0 while h fits
+
+    int16_t _row;  // next row not given to a column yet
+    int16_t _w;    // its width
+    int32_t _werr; // 4a^2(b^2 - row^2) - b^2(2w + 1)^2, > 0 while w + 1 fits
+
+    int16_t _prev; // first row of the previous column
+};
+
+// coordinates past the int16 range are far off screen, keep them there
+static inline int16_t saturate(int32_t v) {
+    return (v < -32768) ? -32768 : (v > 32767) ? 32767 : (int16_t) v;
+}
+
+void Raster::draw_arcs(int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1, uint8_t a, uint8_t b, bool fill,
+                          const pattern_t pattern, Mode mode) {
+    // the error terms stay below 2^28 for any 8 bit radius
+    QuarterArc arc(a, b);
+    uint8_t dx, lo, hi;
+    while (arc.next(dx, lo, hi)) {
+        for (uint8_t side = 0; side < 2; side++) {
+            int32_t x = side ? cx0 - dx : cx1 + dx;
+            if (side && x == cx1 + dx) {
+                break; // center column of an ellipse, already drawn
+            }
+            if (x < -32768 || x > 32767) {
+                continue;
+            }
+            if (fill || lo == 0) {
+                fill_span(x, saturate(cy0 - hi), saturate(cy1 + hi), pattern, mode);
+            } else {
+                fill_span(x, saturate(cy0 - hi), saturate(cy0 - lo), pattern, mode);
+                fill_span(x, saturate(cy1 + lo), saturate(cy1 + hi), pattern, mode);
+            }
+        }
+    }
+}
+
+void Raster::draw_rrect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r, const pattern_t pattern, Mode mode) {
+    if (x0 > x1) {
+        int16_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+
+    if (y0 > y1) {
+        int16_t tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+
+    // the corners can't be larger than the rectangle
+    if (r > (x1 - x0) / 2) {
+        r = (x1 - x0) / 2;
+    }
+    if (r > (y1 - y0) / 2) {
+        r = (y1 - y0) / 2;
+    }
+
+    // corners and sides, then the top and bottom between the corners
+    draw_arcs(x0 + r, y0 + r, x1 - r, y1 - r, r, r, false, pattern, mode);
+    for (int32_t x = x0 + r + 1; x < x1 - r; x++) {
+        fill_span(x, y0, y0, pattern, mode);
+        if (y1 != y0) {
+            fill_span(x, y1, y1, pattern, mode);
+        }
+    }
+}
+
+void Raster::fill_rrect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r, const pattern_t pattern, Mode mode) {
+    if (x0 > x1) {
+        int16_t tmp = x0;
+        x0 = x1;
+        x1 = tmp;
+    }
+
+    if (y0 > y1) {
+        int16_t tmp = y0;
+        y0 = y1;
+        y1 = tmp;
+    }
+
+    if (r > (x1 - x0) / 2) {
+        r = (x1 - x0) / 2;
+    }
+    if (r > (y1 - y0) / 2) {
+        r = (y1 - y0) / 2;
+    }
+
+    draw_arcs(x0 + r, y0 + r, x1 - r, y1 - r, r, r, true, pattern, mode);
+    for (int32_t x = x0 + r + 1; x < x1 - r; x++) {
+        fill_span(x, y0, y1, pattern, mode);
+    }
+}
+
+void Raster::draw_circle(int16_t cx, int16_t cy, uint8_t r, const pattern_t pattern, Mode mode) {
+    draw_arcs(cx, cy, cx, cy, r, r, false, pattern, mode);
+}
+
+void Raster::fill_circle(int16_t cx, int16_t cy, uint8_t r, const pattern_t pattern, Mode mode) {
+    draw_arcs(cx, cy, cx, cy, r, r, true, pattern, mode);
+}
+
+void Raster::draw_ellipse(int16_t cx, int16_t cy, uint8_t a, uint8_t b, const pattern_t pattern, Mode mode) {
+    if (!a || !b) { // flat ellipses are lines
+        fill_ellipse(cx, cy, a, b, pattern, mode);
+        return;
+    }
+
+    draw_arcs(cx, cy, cx, cy, a, b, false, pattern, mode);
+}
+
+void Raster::fill_ellipse(int16_t cx, int16_t cy, uint8_t a, uint8_t b, const pattern_t pattern, Mode mode) {
+    if (!b) {
+        draw_hline(saturate(cx - a), saturate(cx + a), cy, pattern, mode);
+        return;
+    }
+
+    draw_arcs(cx, cy, cx, cy, a, b, true, pattern, mode);
+}
+
+// patterns
+const pattern_t Raster::pattern_black = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+const pattern_t Raster::pattern_dkgrey = {0xEE, 0xBB, 0xEE, 0xBB, 0xEE, 0xBB, 0xEE, 0xBB};
+
+const pattern_t Raster::pattern_grey = {0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55};
+
+const pattern_t Raster::pattern_ltgrey = {0x11, 0x44, 0x11, 0x44, 0x11, 0x44, 0x11, 0x44};
+
+const pattern_t Raster::pattern_white = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
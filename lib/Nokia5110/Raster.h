@@ -0,0 +1,684 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Font.h"
+
+// largest panel, 128x64 (SSD1306)
+#define RASTER_MAX_WIDTH 128
+#define RASTER_MAX_HEIGHT 64
+
+typedef uint8_t pattern_t[8];
+
+// compressed bitmaps: a block header below LCD_RLE_RUN is followed by
+// header + 1 literal bytes, from LCD_RLE_RUN up by one byte repeated
+// (header & 0x7F) + 2 times
+#define LCD_RLE_RUN 0x80
+
+/**
+ * @brief A full screen image in the buffer's bank layout
+ * @details The word view keeps it 32 bit aligned, so whole layers can be
+ * combined a word at a time (126 operations instead of 504 on the Nokia 5110).
+ */
+template <int W, int H>
+union RasterLayer {
+    enum { width = W, height = H, banks = (H + 7) / 8, bytes_size = W * ((H + 7) / 8) };
+
+    uint8_t bytes[bytes_size];
+    uint32_t words[bytes_size / 4];
+};
+
+/**
+ * @brief Draws into a monochrome screen buffer, without any hardware
+ * @details The buffer is in the bank layout shared by the PCD8544 and the
+ * SSD1306: `height / 8` banks of `width` bytes, each byte a column of 8
+ * pixels with the least significant bit on top. The buffer is not owned; a
+ * Display passes its own, sized for its panel.
+ *
+ * Every write grows a dirty box, which the Display hands to its panel so only
+ * the changed part is sent. Nothing here is virtual and nothing depends on
+ * mbed, so the same code also runs on the host.
+ */
+class Raster {
+public:
+    /**
+     * @brief Mode for drawing pixels
+     */
+    enum Mode {
+        pixel_copy = 0x0,
+        pixel_or = 0x1,
+        pixel_xor = 0x2,
+        pixel_clr = 0x3,
+        pixel_invt = 0x4,
+        pixel_nor = 0x5,
+        pixel_xnor = 0x6,
+        pixel_nclr = 0x7
+    };
+
+    // patterns
+    static const pattern_t pattern_black;
+    static const pattern_t pattern_dkgrey;
+    static const pattern_t pattern_grey;
+    static const pattern_t pattern_ltgrey;
+    static const pattern_t pattern_white;
+
+    /**
+     * @brief Mode for filling shapes
+     */
+    enum FillMode {
+        solid,
+        none,
+        hatch,
+        checkerboard,
+        stripes_horiz,
+        stripes_vert
+    };
+
+    /**
+     * @brief constructor, the whole buffer starts dirty
+     *
+     * @param buffer width * height / 32 words
+     * @param width width in pixels, a multiple of 4 up to RASTER_MAX_WIDTH
+     * @param height height in pixels, a multiple of 8 up to RASTER_MAX_HEIGHT
+     */
+    Raster(uint32_t *buffer, uint8_t width, uint8_t height);
+
+    uint8_t width() const { return _width; }
+    uint8_t height() const { return _height; }
+    uint8_t banks() const { return _banks; }
+
+    /**
+     * @brief size of the buffer in bytes
+     */
+    uint16_t bytes() const { return _bytes; }
+
+    /**
+     * @brief the buffer itself, e.g. to export it
+     */
+    const uint8_t *buffer() const { return _buffer; }
+
+    /**
+     * @brief limits drawing to a rectangle of the screen
+     * @details Every drawing call is clipped to this rectangle, which is
+     * always kept inside the screen. Coordinates are signed, so shapes and
+     * bitmaps may start above or left of the screen and only their visible
+     * part is drawn.
+     *
+     * @param x0 column of the first corner
+     * @param y0 row of the first corner
+     * @param x1 column of the second corner
+     * @param y1 row of the second corner
+     */
+    void set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+    /**
+     * @brief draws to the whole screen again
+     */
+    void reset_clip();
+
+    /**
+     * @brief clears the screen buffer
+     */
+    void clear_buffer();
+
+    /**
+     * @brief fills the screen buffer with a pattern
+     *
+     * @param pattern pattern to use
+     */
+    void fill_buffer(const pattern_t pattern);
+
+    /**
+     * @brief inverts every pixel in the screen buffer
+     */
+    void invert_buffer();
+
+    /**
+     * @brief scrolls the screen buffer sideways, clearing the uncovered columns
+     *
+     * @param dx pixels to move, positive is right
+     */
+    void scroll_horiz(int8_t dx);
+
+    /**
+     * @brief scrolls the screen buffer up or down, clearing the uncovered rows
+     * @details Works on 4 columns at once: each bank is shifted within its
+     * bytes and the bits that leave it are carried into the next bank.
+     *
+     * @param dy pixels to move, positive is down
+     */
+    void scroll_vert(int8_t dy);
+
+    /**
+     * @brief copies a rectangle of the screen buffer to another place
+     * @details Overlapping rectangles are fine. The destination is clipped.
+     *
+     * @param x x coordinate of upper left of the source (0 to width() - 1)
+     * @param y y coordinate of upper left of the source (0 to height() - 1)
+     * @param width rectangle width in pixels
+     * @param height rectangle height in pixels
+     * @param dx x coordinate of upper left of the destination
+     * @param dy y coordinate of upper left of the destination
+     * @param mode  draw mode (see above)
+     */
+    void copy_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t dx, int16_t dy,
+                     Mode mode = pixel_copy);
+
+    /**
+     * @brief copies the screen buffer out, e.g. to cache a pre-drawn screen
+     *
+     * @param dst words() words to copy the buffer to
+     */
+    void save_buffer(uint32_t *dst);
+
+    /**
+     * @brief replaces the screen buffer with a saved one
+     * @details Only the words that differ are marked dirty, so loading a
+     * background that is mostly on screen already sends little.
+     *
+     * @param src words, as written by save_buffer()
+     */
+    void load_buffer(const uint32_t *src);
+
+    /**
+     * @brief combines a layer into the screen buffer, 32 bits at a time
+     * @details pixel_or draws the layer's black pixels on top, pixel_clr
+     * erases them, pixel_xor flips them and pixel_copy replaces the buffer.
+     * The inverted modes use the negative of the layer.
+     *
+     * @param layer layer to combine
+     * @param mode  draw mode (see above)
+     */
+    void composite(const uint32_t *layer, Mode mode = pixel_or);
+
+    /**
+     * @brief combines a background and a foreground layer into the screen
+     * buffer in one pass
+     * @details The buffer ends up as `bg` with `fg` drawn on it in `mode`, as
+     * if by load_buffer(bg) then composite(fg, mode), without the copy.
+     *
+     * @param bg background layer
+     * @param fg foreground layer
+     * @param mode  draw mode (see above)
+     */
+    void composite(const uint32_t *bg, const uint32_t *fg, Mode mode = pixel_or);
+
+    // the same for layers, see RasterLayer
+    template <class L> void save_buffer(L &dst) { save_buffer(dst.words); }
+    template <class L> void load_buffer(const L &src) { load_buffer(src.words); }
+    template <class L> void composite(const L &layer, Mode mode = pixel_or) { composite(layer.words, mode); }
+    template <class L> void composite(const L &bg, const L &fg, Mode mode = pixel_or) {
+        composite(bg.words, fg.words, mode);
+    }
+
+    /**
+     * @brief the part of the buffer changed since the last mark_clean()
+     * @details A bounding box in columns and banks, grown by every write to
+     * the buffer. Panels send only this box (see Display::display()).
+     *
+     * @param x0 first column
+     * @param x1 last column
+     * @param bank0 first bank
+     * @param bank1 last bank
+     *
+     * @return false if nothing changed
+     */
+    bool dirty(uint8_t &x0, uint8_t &x1, uint8_t &bank0, uint8_t &bank1) const;
+
+    /**
+     * @brief forgets the changes, once they are on the panel
+     */
+    void mark_clean();
+
+    /**
+     * @brief marks the whole buffer as changed, e.g. when the panel lost
+     * its memory
+     */
+    void mark_dirty();
+
+
+    /**
+     * @brief draws a pixel to the screen buffer
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_pixel(int16_t x, int16_t y, const pattern_t pattern, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a pixel to the screen buffer
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param value pixel value. 0 = white, 1 = black in normal mode
+     * @param mode  draw mode (see above)
+     */
+    void draw_pixel(int16_t x, int16_t y, bool value, Mode mode = pixel_copy);
+
+    /**
+     * @brief gets the value of a pixel from the screen buffer
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     *
+     * @return value of the pixel, 0 if white or off screen
+     */
+    uint8_t get_pixel(int16_t x, int16_t y);
+
+    /**
+     * @brief draws a byte to the screen buffer
+     *
+     * @param x x coordinate, (0 to width() - 1)
+     * @param bank memory bank (0 to banks() - 1)
+     * @param byte byte to draw
+     */
+    void draw_byte(uint8_t x, uint8_t bank, uint8_t byte);
+
+    /**
+     * @brief gets a byte from the screen buffer
+     *
+     * @param x x coordinate (0 to width() - 1)
+     * @param bank memory bank (0 to banks() - 1)
+     *
+     * @return byte from the screen buffer
+     */
+    uint8_t get_byte(uint8_t x, uint8_t y);
+
+    /**
+     * @brief prints a 7x5 character
+     *
+     * @param c character to draw
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param mode  draw mode (see above)
+     *
+     * @return next column to print to
+     */
+    int16_t print_char(char c, int16_t x, int16_t y, Mode mode = pixel_copy);
+
+    /**
+     * @brief prints a string
+     *
+     * @param str string to print
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param chars maximum number of chars to print.
+     *        -1 = no limit. stops at null byte or past the clip rectangle
+     * @param mode  draw mode (see above)
+     *
+     * @return next column to print to
+     */
+    int16_t print_string(const char *str, int16_t x, int16_t y, int8_t chars = -1, Mode mode = pixel_copy);
+
+    /**
+     * @brief prints a character in the given font
+     *
+     * @param c character to draw
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param font font to use
+     * @param mode  draw mode (see above)
+     *
+     * @return next column to print to
+     */
+    int16_t print_char(char c, int16_t x, int16_t y, const Font &font, Mode mode = pixel_copy);
+
+    /**
+     * @brief prints a string in the given font
+     * @details Use measure_string() to lay the text out first, e.g. to center
+     * it; it gives the same width this draws.
+     *
+     * @param str string to print
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param font font to use
+     * @param mode  draw mode (see above)
+     *
+     * @return next column to print to
+     */
+    int16_t print_string(const char *str, int16_t x, int16_t y, const Font &font, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a bitmap in an unpadded format
+     *
+     * @param bmp pointer to the start of the bitmap
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param width bitmap width in pixels
+     * @param height bitmap height in pixels
+     */
+    void draw_bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a bitmap in the WBMP format
+     *
+     * @param wbmp pointer to the start of the bitmap
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     */
+    void draw_wbitmap(const uint8_t *wbmp, int16_t x, int16_t y, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a bitmap stored in the display's native layout
+     * @details The bitmap is ceil(height / 8) rows of `width` bytes; each byte
+     * is a column of 8 pixels with the least significant bit on top, just
+     * like the screen buffer. Whole bytes are shifted and masked into place,
+     * so any y works and the cost is about one or two buffer writes per 8
+     * pixels. Pixels outside the clip rectangle are skipped. Use
+     * tools/bmpconv.cpp to convert WBMP, PBM or draw_bitmap() data to this
+     * layout.
+     *
+     * @param bmp pointer to the start of the bitmap
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param width bitmap width in pixels
+     * @param height bitmap height in pixels
+     * @param mode  draw mode (see above)
+     */
+    void blit_bitmap(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a run-length compressed bitmap
+     * @details The data is the native layout byte stream of blit_bitmap(),
+     * packed in blocks of repeated or literal bytes (see LCD_RLE_RUN); blocks
+     * may cross rows. It is decoded straight into the screen buffer: runs
+     * become memset() and literals memcpy() when the bitmap is bank aligned.
+     * Use tools/bmpconv.cpp -rle to pack images.
+     *
+     * @param rle pointer to the compressed data
+     * @param x x coordinate of upper left
+     * @param y y coordinate of upper left
+     * @param width bitmap width in pixels
+     * @param height bitmap height in pixels
+     * @param mode  draw mode (see above)
+     */
+    void blit_rle(const uint8_t *rle, int16_t x, int16_t y, uint8_t width, uint8_t height, Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a line
+     * @details Only the part inside the clip rectangle is walked: the error
+     * term is worked out for the first visible pixel, so a clipped line has
+     * the same pixels as the whole line, however far its ends are.
+     *
+     * @param x0 x coordinate of first point
+     * @param y0 y coordinate of first point
+     * @param x1 x coordinate of second point
+     * @param y1 y coordinate of second point
+     * @param mode  draw mode (see above)
+     */
+    void draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                   const pattern_t pattern = pattern_black,
+                   Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a horizontal line
+     *
+     * @param x0 x coordinate of first point
+     * @param x1 x coordinate of second point
+     * @param y  y coordinate of the line
+     * @param mode  draw mode (see above)
+     */
+    void draw_hline(int16_t x0, int16_t x1, int16_t y,
+                    const pattern_t pattern = pattern_black,
+                    Mode mode = pixel_copy);
+
+    /**
+     * @brief draws a vertical line
+     *
+     * @param y0 y coordinate of first point
+     * @param y1 y coordinate of second point
+     * @param x  x coordinate of the line
+     * @param mode  draw mode (see above)
+     */
+    void draw_vline(int16_t y0, int16_t y1, int16_t x,
+                    const pattern_t pattern = pattern_black,
+                    Mode mode = pixel_copy);
+
+    /**
+     * @brief draws an empty rectangle
+     *
+     * @param x0 column of the first point
+     * @param y0 row of the first point
+     * @param x1 column of the second point
+     * @param y1 row of the second point
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                   const pattern_t pattern = pattern_black,
+                   Mode mode = pixel_copy);
+
+    /**
+     * @brief fills a rectangle
+     *
+     * @param x0 column of the first point
+     * @param y0 row of the first point
+     * @param x1 column of the second point
+     * @param y1 row of the second point
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                   const pattern_t pattern = pattern_black,
+                   Mode mode = pixel_copy);
+
+    /**
+     * @brief draws an empty rounded rectangle
+     *
+     * @param x0 column of first point
+     * @param y0 row of first point
+     * @param x1 column of second point
+     * @param y1 row of second point
+     * @param r radius
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_rrect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r,
+                    const pattern_t pattern = pattern_black,
+                    Mode mode = pixel_copy);
+
+    /**
+     * @brief fills a rounded rectangle
+     *
+     * @param x0 column of first point
+     * @param y0 row of first point
+     * @param x1 column of second point
+     * @param y1 row of second point
+     * @param r radius
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void fill_rrect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t r,
+                    const pattern_t pattern = pattern_black,
+                    Mode mode = pixel_copy);
+
+    /**
+     * @brief draws an empty circle
+     * 
+     * @param cx x coordinate of the center
+     * @param cy y coordinate of the center
+     * @param r radius of the circle
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_circle(int16_t cx, int16_t cy, uint8_t r,
+                     const pattern_t pattern = pattern_black,
+                     Mode mode = pixel_copy);
+
+    /**
+     * @brief fills a circle
+     *
+     * @param cx x coordinate of the center
+     * @param cy y coordinate of the center
+     * @param r radius of the circle
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void fill_circle(int16_t cx, int16_t cy, uint8_t r,
+                     const pattern_t pattern = pattern_black,
+                     Mode mode = pixel_copy);
+
+    /**
+     * @brief draws an empty ellipse
+     * 
+     * @param cx x coordinate of the center
+     * @param cy y coordinate of the center
+     * @param a horizontal radius of the ellipse
+     * @param b vertical radius of the ellipse
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_ellipse(int16_t cx, int16_t cy, uint8_t a, uint8_t b,
+                      const pattern_t pattern = pattern_black,
+                      Mode mode = pixel_copy);
+
+    /**
+     * @brief fills an ellipse
+     *
+     * @param cx x coordinate of the center
+     * @param cy y coordinate of the center
+     * @param a horizontal radius of the ellipse
+     * @param b vertical radius of the ellipse
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void fill_ellipse(int16_t cx, int16_t cy, uint8_t a, uint8_t b,
+                      const pattern_t = pattern_black,
+                      Mode mode = pixel_copy);
+
+private:
+    /**
+     * @brief draws an 8 pixel column strip at any y
+     *
+     * @param col x coordinate
+     * @param y y coordinate of the top pixel
+     * @param bits pixels, least significant bit on top
+     * @param mask which of the 8 pixels to touch
+     * @param mode  draw mode (see above)
+     */
+    void blit_byte(int16_t col, int16_t y, uint8_t bits, uint8_t mask, Mode mode);
+
+    /**
+     * @brief draws part of one 8 pixel row of a native layout bitmap
+     *
+     * @param x x coordinate of the bitmap's left edge
+     * @param top y coordinate of the row's top pixel
+     * @param mask which of the 8 pixels of the row to touch
+     * @param src column bytes from column `from` on, or NULL to repeat `value`
+     * @param value column byte used when src is NULL
+     * @param from first column, relative to x
+     * @param len number of columns
+     * @param mode  draw mode (see above)
+     */
+    void blit_row(int16_t x, int16_t top, uint8_t mask, const uint8_t *src, uint8_t value,
+                  uint8_t from, uint8_t len, Mode mode);
+
+    /**
+     * @brief sets a pixel that is known to be inside the clip rectangle
+     *
+     * @param x x coordinate
+     * @param y y coordinate
+     * @param value pixel value
+     * @param mode  draw mode (see above)
+     */
+    void plot(int16_t x, int16_t y, bool value, Mode mode);
+
+    /**
+     * @brief which rows of a bank are inside the clip rectangle
+     *
+     * @param bank memory bank, may be off screen
+     *
+     * @return one bit per row, 0 for banks off screen
+     */
+    uint8_t clip_bank(int16_t bank);
+
+    /**
+     * @brief draws a vertical span a byte at a time, clipped
+     *
+     * @param x x coordinate of the span
+     * @param y0 y coordinate of one end
+     * @param y1 y coordinate of the other end
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void fill_span(int16_t x, int16_t y0, int16_t y1, const pattern_t pattern, Mode mode);
+
+    /**
+     * @brief draws four quarter ellipses as vertical spans
+     * @details The quarters are centered on the corners of the rectangle
+     * cx0,cy0 - cx1,cy1, and the sides between them are drawn too, so it
+     * covers ellipses (a single center) and rounded rectangles.
+     *
+     * @param cx0 left center
+     * @param cy0 top center
+     * @param cx1 right center
+     * @param cy1 bottom center
+     * @param a horizontal radius
+     * @param b vertical radius
+     * @param fill fill the shape or only draw the outline
+     * @param pattern pattern to use
+     * @param mode  draw mode (see above)
+     */
+    void draw_arcs(int16_t cx0, int16_t cy0, int16_t cx1, int16_t cy1, uint8_t a, uint8_t b, bool fill,
+                   const pattern_t pattern, Mode mode);
+
+    // grows the dirty box to cover columns x0-x1 of banks bank0-bank1
+    void touch(int16_t x0, int16_t x1, int16_t bank0, int16_t bank1) {
+        if (x0 < _dirty_x0) {
+            _dirty_x0 = x0;
+        }
+        if (x1 > _dirty_x1) {
+            _dirty_x1 = x1;
+        }
+        if (bank0 < _dirty_b0) {
+            _dirty_b0 = bank0;
+        }
+        if (bank1 > _dirty_b1) {
+            _dirty_b1 = bank1;
+        }
+    }
+
+    // the same buffer as bytes and as words
+    uint8_t *_buffer;
+    uint32_t *_words;
+
+    uint8_t _width;
+    uint8_t _height;
+    uint8_t _banks;
+    uint8_t _row_words; // words per bank
+    uint16_t _bytes;
+    uint16_t _word_count;
+
+    // clip rectangle, inclusive and always on screen
+    int16_t _clip_x0;
+    int16_t _clip_y0;
+    int16_t _clip_x1;
+    int16_t _clip_y1;
+
+    // dirty box, empty while _dirty_x0 > _dirty_x1
+    int16_t _dirty_x0;
+    int16_t _dirty_x1;
+    int16_t _dirty_b0;
+    int16_t _dirty_b1;
+};
+
+#endif
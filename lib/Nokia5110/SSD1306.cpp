@@ -0,0 +1,104 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#include "SSD1306.h"
+
+SSD1306::SSD1306(PinName cs, PinName rst, PinName dc, PinName mosi, PinName sclk)
+    : _spi(mosi, NC, sclk), _cs(cs, 1), _rst(rst, 1), _dc(dc, 0) {
+    _spi.format(SSD1306_SPI_BITS, SSD1306_SPI_MODE);
+    _spi.frequency(SSD1306_SPI_FREQ);
+}
+
+void SSD1306::init(uint8_t con) {
+    reset();
+
+    const uint8_t cmds[] = {
+        SSD1306_DISPLAYOFF,
+        SSD1306_CLOCKDIV, 0x80,
+        SSD1306_MULTIPLEX, SSD1306_HEIGHT - 1,
+        SSD1306_DISPLAYOFFSET, 0x00,
+        SSD1306_STARTLINE | 0,
+        SSD1306_CHARGEPUMP, 0x14,
+        SSD1306_MEMORYMODE, SSD1306_HORIZONTAL,
+        SSD1306_SEGREMAP | 0x1,
+        SSD1306_COMSCANDEC,
+        SSD1306_COMPINS, 0x12,
+        SSD1306_SETCONTRAST, con,
+        SSD1306_PRECHARGE, 0xF1,
+        SSD1306_VCOMDETECT, 0x40,
+        SSD1306_DISPLAYRAM,
+        SSD1306_NORMAL,
+        SSD1306_DISPLAYON
+    };
+    send_commands(cmds, sizeof(cmds));
+}
+
+void SSD1306::reset() {
+    _rst.write(0);
+    wait_us(SSD1306_RESET_US);
+    _rst.write(1);
+    wait_us(SSD1306_RESET_US);
+}
+
+void SSD1306::send_command(uint8_t cmd) {
+    send_commands(&cmd, 1);
+}
+
+void SSD1306::send_commands(const uint8_t *cmds, uint8_t len) {
+    _cs.write(0);
+
+    for (uint8_t i = 0; i < len; i++) {
+        _spi.write(cmds[i]);
+    }
+
+    _cs.write(1);
+}
+
+void SSD1306::set_contrast(uint8_t con) {
+    const uint8_t cmds[] = { SSD1306_SETCONTRAST, con };
+    send_commands(cmds, sizeof(cmds));
+}
+
+void SSD1306::set_inverted(bool inverted) {
+    send_command(inverted ? SSD1306_INVERTED : SSD1306_NORMAL);
+}
+
+void SSD1306::set_power(uint8_t pow) {
+    send_command(pow ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF);
+}
+
+uint16_t SSD1306::flush(const uint8_t *buffer, uint8_t x0, uint8_t x1, uint8_t bank0, uint8_t bank1) {
+    const uint8_t window[] = {
+        SSD1306_COLUMNADDR, x0, x1,
+        SSD1306_PAGEADDR, bank0, bank1
+    };
+    send_commands(window, sizeof(window));
+
+    // the box row by row, in one transfer
+    uint8_t len = x1 - x0 + 1;
+    _dc.write(1);
+    _cs.write(0);
+    for (uint8_t bank = bank0; bank <= bank1; bank++) {
+        const uint8_t *row = &buffer[x0 + bank * SSD1306_WIDTH];
+        for (uint8_t i = 0; i < len; i++) {
+            _spi.write(row[i]);
+        }
+    }
+    _cs.write(1);
+    _dc.write(0);
+
+    return sizeof(window) + len * (bank1 - bank0 + 1);
+}
@@ -0,0 +1,161 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef SSD1306_H
+#define SSD1306_H
+
+#include <mbed.h>
+
+// 8MHz clock frequency, the controller takes up to 10MHz
+#define SSD1306_SPI_FREQ 8000000
+#define SSD1306_SPI_BITS 0x08
+#define SSD1306_SPI_MODE 0x00
+
+// reset pulse, the datasheet asks for 3us minimum
+#define SSD1306_RESET_US 5
+
+#define SSD1306_WIDTH 128
+#define SSD1306_HEIGHT 64
+
+// fundamental commands
+#define SSD1306_SETCONTRAST 0x81
+#define SSD1306_DISPLAYRAM 0xA4
+#define SSD1306_NORMAL 0xA6
+#define SSD1306_INVERTED 0xA7
+#define SSD1306_DISPLAYOFF 0xAE
+#define SSD1306_DISPLAYON 0xAF
+
+// addressing
+#define SSD1306_MEMORYMODE 0x20
+#define SSD1306_HORIZONTAL 0x00
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+
+// hardware configuration
+#define SSD1306_STARTLINE 0x40
+#define SSD1306_SEGREMAP 0xA0
+#define SSD1306_MULTIPLEX 0xA8
+#define SSD1306_COMSCANDEC 0xC8
+#define SSD1306_DISPLAYOFFSET 0xD3
+#define SSD1306_COMPINS 0xDA
+
+// timing and driving
+#define SSD1306_CLOCKDIV 0xD5
+#define SSD1306_PRECHARGE 0xD9
+#define SSD1306_VCOMDETECT 0xDB
+#define SSD1306_CHARGEPUMP 0x8D
+
+/**
+ * @brief The SSD1306 controller of 128x64 monochrome OLED modules, over
+ * 4 wire SPI
+ * @details The display RAM has the same layout as the PCD8544's: 8 pages of
+ * 128 bytes, a byte is a column of 8 pixels with the least significant bit on
+ * top. Takes the same pins as PCD8544, so either panel can go in a Display.
+ */
+class SSD1306 {
+public:
+    enum {
+        WIDTH = SSD1306_WIDTH,
+        HEIGHT = SSD1306_HEIGHT
+    };
+
+    typedef PinName Pin;
+
+    /**
+     * @brief constructor
+     *
+     * @param cs Chip Select pin
+     * @param rst Reset pin
+     * @param dc D/C pin
+     * @param mosi data pin (MOSI)
+     * @param sclk clock pin (SCLK)
+     */
+    SSD1306(PinName cs, PinName rst, PinName dc, PinName mosi, PinName sclk);
+
+    /**
+     * @brief initialize the display with the charge pump on, horizontal
+     * addressing and the given contrast, in one transfer
+     *
+     * @param con contrast (0-255)
+     */
+    void init(uint8_t con = 0xCF);
+
+    /**
+     * @brief reset the controller
+     */
+    void reset();
+
+    /**
+     * @brief send a command to the display
+     *
+     * @param cmd command to send
+     */
+    void send_command(uint8_t cmd);
+
+    /**
+     * @brief send several commands in a single transfer
+     *
+     * @param cmds commands to send
+     * @param len number of commands
+     */
+    void send_commands(const uint8_t *cmds, uint8_t len);
+
+    /**
+     * @brief sets the display's contrast
+     *
+     * @param con contrast (0-255)
+     */
+    void set_contrast(uint8_t con);
+
+    /**
+     * @brief shows the pixels inverted or not
+     *
+     * @param inverted true for light pixels on a dark background
+     */
+    void set_inverted(bool inverted);
+
+    /**
+     * @brief turns the display on or off, the RAM is kept
+     *
+     * @param pow power, 0 = off, 1 = on
+     */
+    void set_power(uint8_t pow);
+
+    /**
+     * @brief sends part of a screen buffer to the display
+     * @details The column and page windows are set to the box, and the
+     * controller wraps its pointer inside them, so the whole box goes out as
+     * a single transfer whatever its width.
+     *
+     * @param buffer screen buffer in the bank layout, SSD1306_WIDTH bytes per page
+     * @param x0 first column
+     * @param x1 last column
+     * @param bank0 first page
+     * @param bank1 last page
+     *
+     * @return bytes sent, commands included
+     */
+    uint16_t flush(const uint8_t *buffer, uint8_t x0, uint8_t x1, uint8_t bank0, uint8_t bank1);
+
+private:
+    SPI _spi;
+
+    DigitalOut _cs;
+    DigitalOut _rst;
+    DigitalOut _dc;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#include <string.h>
+#include "TileMap.h"
+
+TileMap::TileMap(Raster &lcd, const uint8_t *atlas, uint8_t size) : _lcd(lcd), _atlas(atlas) {
+    _size = (size == 4) ? 4 : 8;
+    _cols = lcd.width() / _size;
+    _rows = lcd.height() / _size;
+
+    memset(_tiles, 0, sizeof(_tiles));
+    invalidate();
+}
+
+void TileMap::set_tile(uint8_t col, uint8_t row, uint8_t tile) {
+    if (col >= _cols || row >= _rows) {
+        return;
+    }
+
+    uint16_t index = col + row * _cols;
+    if (_tiles[index] != tile) {
+        _tiles[index] = tile;
+        mark(index);
+    }
+}
+
+uint8_t TileMap::get_tile(uint8_t col, uint8_t row) {
+    if (col >= _cols || row >= _rows) {
+        return 0;
+    }
+
+    return _tiles[col + row * _cols];
+}
+
+void TileMap::fill(uint8_t tile) {
+    memset(_tiles, tile, sizeof(_tiles));
+    invalidate();
+}
+
+void TileMap::invalidate() {
+    memset(_dirty, 0xFF, sizeof(_dirty));
+}
+
+void TileMap::draw_sprite(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height, Raster::Mode mode) {
+    _lcd.blit_bitmap(bmp, x, y, width, height, mode);
+
+    // tiles under the visible part of the sprite
+    int16_t x0 = (x < 0) ? 0 : x;
+    int16_t y0 = (y < 0) ? 0 : y;
+    int16_t x1 = x + width - 1;
+    int16_t y1 = y + height - 1;
+    if (!width || !height || x1 < 0 || y1 < 0) {
+        return;
+    }
+
+    for (int16_t row = y0 / _size; row <= y1 / _size && row < _rows; row++) {
+        for (int16_t col = x0 / _size; col <= x1 / _size && col < _cols; col++) {
+            mark(col + row * _cols);
+        }
+    }
+}
+
+uint16_t TileMap::render(Raster::Mode mode) {
+    uint16_t drawn = 0;
+    uint16_t count = _cols * _rows;
+
+    for (uint16_t i = 0; i < count; i += 8) {
+        uint8_t bits = _dirty[i / 8];
+        if (!bits) {
+            continue; // 8 clean tiles at once
+        }
+        _dirty[i / 8] = 0;
+
+        for (uint8_t b = 0; b < 8 && i + b < count; b++) {
+            if (!(bits & (1 << b))) {
+                continue;
+            }
+            uint16_t index = i + b;
+            uint8_t col = index % _cols;
+            uint8_t row = index / _cols;
+            _lcd.blit_bitmap(_atlas + _tiles[index] * _size, col * _size, row * _size, _size, _size, mode);
+            drawn++;
+        }
+    }
+
+    return drawn;
+}
+
+void TileMap::mark(uint16_t index) {
+    _dirty[index / 8] |= 1 << (index % 8);
+}
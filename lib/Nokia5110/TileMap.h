@@ -0,0 +1,122 @@
+/*
+   Copyright 2017 Andrew Cassidy
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "Raster.h"
+
+// largest map, reached with 4x4 tiles
+#define TILE_MAX_COLS (RASTER_MAX_WIDTH / 4)
+#define TILE_MAX_ROWS (RASTER_MAX_HEIGHT / 4)
+#define TILE_MAX_TILES (TILE_MAX_COLS * TILE_MAX_ROWS)
+
+/**
+ * @brief A grid of fixed size tiles drawn into a screen buffer
+ * @details Tiles are 8x8 or 4x4 pixels, so they line up with the display's
+ * 8 pixel banks: an 8x8 tile is 8 bytes copied straight into the buffer and a
+ * 4x4 tile is 4 half bytes. The tile images live in an atlas in flash, in the
+ * native layout (see Raster::blit_bitmap): `size` column bytes per tile,
+ * least significant bit on top, only the low nibble used by 4x4 tiles.
+ *
+ * Only tiles that changed since the last render() are drawn again, so a
+ * screen where a few tiles change per frame costs a few byte writes, provided
+ * the buffer is not cleared between frames.
+ */
+class TileMap {
+public:
+    /**
+     * @brief constructor, all tiles start as tile 0 and dirty
+     *
+     * @param lcd display whose buffer is drawn into
+     * @param atlas tile images, `size` bytes each
+     * @param size tile size in pixels, 4 or 8
+     */
+    TileMap(Raster &lcd, const uint8_t *atlas, uint8_t size = 8);
+
+    /**
+     * @brief sets a tile, marking it dirty if it changed
+     *
+     * @param col tile column (0-cols())
+     * @param row tile row (0-rows())
+     * @param tile index in the atlas
+     */
+    void set_tile(uint8_t col, uint8_t row, uint8_t tile);
+
+    /**
+     * @brief gets a tile
+     *
+     * @param col tile column (0-cols())
+     * @param row tile row (0-rows())
+     *
+     * @return index in the atlas
+     */
+    uint8_t get_tile(uint8_t col, uint8_t row);
+
+    /**
+     * @brief sets every tile
+     *
+     * @param tile index in the atlas
+     */
+    void fill(uint8_t tile);
+
+    /**
+     * @brief marks every tile dirty, e.g. after the buffer was cleared
+     */
+    void invalidate();
+
+    /**
+     * @brief draws a bitmap on top of the tiles
+     * @details The sprite goes straight into the buffer and the tiles under it
+     * are marked dirty, so the next render() restores them.
+     *
+     * @param bmp bitmap in the native layout
+     * @param x x coordinate of upper left, may be off screen
+     * @param y y coordinate of upper left, may be off screen
+     * @param width bitmap width in pixels
+     * @param height bitmap height in pixels
+     * @param mode  draw mode
+     */
+    void draw_sprite(const uint8_t *bmp, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                     Raster::Mode mode = Raster::pixel_or);
+
+    /**
+     * @brief draws the dirty tiles into the buffer
+     *
+     * @param mode  draw mode
+     *
+     * @return number of tiles drawn
+     */
+    uint16_t render(Raster::Mode mode = Raster::pixel_copy);
+
+    uint8_t cols() { return _cols; }
+    uint8_t rows() { return _rows; }
+    uint8_t size() { return _size; }
+
+private:
+    void mark(uint16_t index);
+
+    Raster &_lcd;
+    const uint8_t *_atlas;
+    uint8_t _size;
+    uint8_t _cols;
+    uint8_t _rows;
+
+    uint8_t _tiles[TILE_MAX_TILES];
+    uint8_t _dirty[(TILE_MAX_TILES + 7) / 8];
+};
+
+#endif
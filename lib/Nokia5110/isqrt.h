@@ -19,7 +19,7 @@
 
 #include <stdint.h>
 
-uint16_t isqrt(uint16_t a_nInput) {
+static inline uint16_t isqrt(uint16_t a_nInput) {
     uint16_t op = a_nInput;
     uint16_t res = 0;
     uint16_t one = 1uL << 14; // The second-to-top bit is set: use 1u << 14 for uint16_t type; use 1uL<<30 for uint32_t type
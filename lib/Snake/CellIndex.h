@@ -0,0 +1,225 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Indice del tablero: tipo de cada celda y un mapa de bits por fila y tipo
+*/
+
+#ifndef CELLINDEX_H_
+    #define CELLINDEX_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "CellPlane.h"
+
+/**
+ * @brief What lies on each cell of a W x H board, searchable by type
+ * @details The 2 bit plane answers "what is on cell x, y" with one lookup.
+ * Next to it every non empty type keeps a bitset per row and a bitset of the
+ * rows holding at least one cell of that type, so walking the cells of a
+ * type skips empty rows and empty words, and nearest() looks at one row
+ * pair per unit of distance and stops as soon as no closer row is left.
+ * Both stay as fast with a hundred fruits as with one.
+ */
+template <int W, int H>
+class BasicCellIndex
+{
+public:
+    enum {
+        rows = H + 2,                // frame included, like the plane
+        row_words = (W + 2 + 31) / 32,
+        row_set_words = (rows + 31) / 32,
+        types = 3                    // cell_fruit, cell_wall, cell_obstacle
+    };
+
+    BasicCellIndex() { clear(); }
+
+    /**
+     * @brief empties every cell
+     */
+    void clear();
+
+    /**
+     * @brief reads a cell
+     *
+     * @param x column (0-W+1)
+     * @param y row (0-H+1)
+     *
+     * @return cell value, cell_wall outside the board
+     */
+    uint8_t get(int x, int y) const { return _plane.get(x, y); }
+
+    /**
+     * @brief writes a cell, ignored outside the board
+     *
+     * @param x column (0-W+1)
+     * @param y row (0-H+1)
+     * @param value cell_empty, cell_fruit, cell_wall or cell_obstacle
+     */
+    void set(int x, int y, uint8_t value);
+
+    /**
+     * @brief number of cells holding a type
+     */
+    uint16_t count(uint8_t type) const { return type ? _count[type - 1] : 0; }
+
+    /**
+     * @brief first cell of a type in a row, from a column on
+     *
+     * @param type cell_fruit, cell_wall or cell_obstacle
+     * @param y row (0-H+1)
+     * @param x first column to look at
+     *
+     * @return its column, -1 if there is none
+     */
+    int next_in_row(uint8_t type, int y, int x) const;
+
+    /**
+     * @brief closest cell of a type to x, y in steps along the grid
+     *
+     * @param type cell_fruit, cell_wall or cell_obstacle
+     * @param x column to measure from
+     * @param y row to measure from
+     * @param fx column found
+     * @param fy row found
+     *
+     * @return false if no cell holds the type
+     */
+    bool nearest(uint8_t type, int x, int y, int &fx, int &fy) const;
+
+private:
+    bool row_holds(uint8_t type, int y) const
+    {
+        return _row_set[type - 1][y / 32] & (1UL << (y % 32));
+    }
+
+    int prev_in_row(uint8_t type, int y, int x) const;
+
+    BasicCellPlane<W, H> _plane;
+    uint16_t _count[types];
+    uint32_t _row_set[types][row_set_words];   // rows holding the type
+    uint32_t _bits[types][rows][row_words];    // cells holding the type
+};
+
+typedef BasicCellIndex<SNAKE_WIDTH, SNAKE_HEIGHT> CellIndex;
+
+template <int W, int H>
+void BasicCellIndex<W, H>::clear()
+{
+    _plane.clear();
+    memset(_count, 0, sizeof(_count));
+    memset(_row_set, 0, sizeof(_row_set));
+    memset(_bits, 0, sizeof(_bits));
+}
+
+template <int W, int H>
+void BasicCellIndex<W, H>::set(int x, int y, uint8_t value)
+{
+    if (x < 0 || x > W + 1 || y < 0 || y > H + 1) {
+        return;
+    }
+    uint8_t old = _plane.get(x, y);
+    if (old == value) {
+        return;
+    }
+    _plane.set(x, y, value);
+
+    uint32_t bit = 1UL << (x % 32);
+    if (old != cell_empty) {
+        uint32_t *row = _bits[old - 1][y];
+        row[x / 32] &= ~bit;
+        _count[old - 1]--;
+        if (!row[x / 32]) {
+            bool any = false;
+            for (uint8_t w = 0; w < row_words; w++) {
+                any |= row[w] != 0;
+            }
+            if (!any) {
+                _row_set[old - 1][y / 32] &= ~(1UL << (y % 32));
+            }
+        }
+    }
+    if (value != cell_empty) {
+        _bits[value - 1][y][x / 32] |= bit;
+        _row_set[value - 1][y / 32] |= 1UL << (y % 32);
+        _count[value - 1]++;
+    }
+}
+
+template <int W, int H>
+int BasicCellIndex<W, H>::next_in_row(uint8_t type, int y, int x) const
+{
+    if (x < 0) {
+        x = 0;
+    }
+    if (y < 0 || y >= rows || x > W + 1 || !row_holds(type, y)) {
+        return -1;
+    }
+    const uint32_t *row = _bits[type - 1][y];
+    uint8_t w = x / 32;
+    uint32_t word = row[w] & (0xFFFFFFFFUL << (x % 32));
+    while (!word) {
+        if (++w == row_words) {
+            return -1;
+        }
+        word = row[w];
+    }
+    return w * 32 + __builtin_ctz(word);
+}
+
+// last cell of a type in a row up to a column, -1 if there is none
+template <int W, int H>
+int BasicCellIndex<W, H>::prev_in_row(uint8_t type, int y, int x) const
+{
+    if (x > W + 1) {
+        x = W + 1;
+    }
+    if (x < 0) {
+        return -1;
+    }
+    const uint32_t *row = _bits[type - 1][y];
+    int w = x / 32;
+    uint32_t word = row[w] & (0xFFFFFFFFUL >> (31 - x % 32));
+    while (!word) {
+        if (--w < 0) {
+            return -1;
+        }
+        word = row[w];
+    }
+    return w * 32 + 31 - __builtin_clz(word);
+}
+
+template <int W, int H>
+bool BasicCellIndex<W, H>::nearest(uint8_t type, int x, int y, int &fx, int &fy) const
+{
+    if (!count(type)) {
+        return false;
+    }
+
+    // rows d above and below cost at least d, so the search stops once d
+    // reaches the best distance found
+    int best = 0x7FFF;
+    for (int d = 0; d < best && (y - d >= 0 || y + d < rows); d++) {
+        for (uint8_t side = 0; side < 2; side++) {
+            int ry = side ? y + d : y - d;
+            if ((side && d == 0) || ry < 0 || ry >= rows || !row_holds(type, ry)) {
+                continue;
+            }
+            int right = next_in_row(type, ry, x);
+            int left = prev_in_row(type, ry, x);
+            if (right >= 0 && d + right - x < best) {
+                best = d + right - x;
+                fx = right;
+                fy = ry;
+            }
+            if (left >= 0 && d + x - left < best) {
+                best = d + x - left;
+                fx = left;
+                fy = ry;
+            }
+        }
+    }
+    return true;
+}
+
+#endif /* !CELLINDEX_H_ */
@@ -0,0 +1,82 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Mapa del tablero con 2 bits por celda
+*/
+
+#ifndef CELLPLANE_H_
+    #define CELLPLANE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "SnakeBody.h"
+
+/**
+ * @brief what a cell holds, fits in 2 bits
+ */
+enum cell_type {
+    cell_empty = 0,
+    cell_fruit = 1,
+    cell_wall = 2,
+    cell_obstacle = 3, // moves on its own, deadly like a wall
+    cell_snake = 4     // only given by SnakeGame::cell(), never stored
+};
+
+/**
+ * @brief One 2 bit value per cell of a W x H board, frame included
+ * @details Four cells per byte, indexed like snake_cell: about 1 KB for the
+ * default board instead of an int per cell.
+ */
+template <int W, int H>
+class BasicCellPlane
+{
+public:
+    BasicCellPlane() { clear(); }
+
+    /**
+     * @brief sets every cell to cell_empty
+     */
+    void clear() { memset(_bits, 0, sizeof(_bits)); }
+
+    /**
+     * @brief reads a cell
+     *
+     * @param x column (0-W+1)
+     * @param y row (0-H+1)
+     *
+     * @return cell value, cell_wall outside the board
+     */
+    uint8_t get(int x, int y) const
+    {
+        if (x < 0 || x > W + 1 || y < 0 || y > H + 1) {
+            return cell_wall;
+        }
+        snake_cell cell = BasicSnakeBody<W, H>::cell_of(x, y);
+        return (_bits[cell / 4] >> (2 * (cell % 4))) & 3;
+    }
+
+    /**
+     * @brief writes a cell, ignored outside the board
+     *
+     * @param x column (0-W+1)
+     * @param y row (0-H+1)
+     * @param value cell value (0-3)
+     */
+    void set(int x, int y, uint8_t value)
+    {
+        if (x < 0 || x > W + 1 || y < 0 || y > H + 1) {
+            return;
+        }
+        snake_cell cell = BasicSnakeBody<W, H>::cell_of(x, y);
+        uint8_t shift = 2 * (cell % 4);
+        _bits[cell / 4] = (_bits[cell / 4] & ~(3 << shift)) | ((value & 3) << shift);
+    }
+
+private:
+    uint8_t _bits[((W + 2) * (H + 2) + 3) / 4];
+};
+
+typedef BasicCellPlane<SNAKE_WIDTH, SNAKE_HEIGHT> CellPlane;
+
+#endif /* !CELLPLANE_H_ */
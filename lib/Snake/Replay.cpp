@@ -0,0 +1,174 @@
+#include "Replay.h"
+
+#define NO_EVENT 0xFFFFFFFF
+
+static const directions code_dirs[4] = {up, right, down, left};
+
+static uint8_t dir_code(directions d)
+{
+    switch (d) {
+    case up:
+        return 0;
+    case right:
+        return 1;
+    case down:
+        return 2;
+    default:
+        return 3;
+    }
+}
+
+ReplayRecorder::ReplayRecorder()
+{
+    _size = 0;
+    _tick = 0;
+    _last_event = 0;
+    _dir = right;
+    _finished = false;
+    _truncated = false;
+}
+
+void ReplayRecorder::begin(uint32_t seed, const GameMode &mode)
+{
+    _size = 0;
+    _tick = 0;
+    _last_event = 0; // events count from tick -1, see the format
+    _dir = right;
+    _finished = false;
+    _truncated = false;
+
+    _buffer[_size++] = REPLAY_VERSION;
+    put(seed);
+    put(mode.fruits);
+    put(mode.walls);
+    put(mode.obstacles);
+}
+
+void ReplayRecorder::tick(directions dir)
+{
+    if (dir != _dir && !_truncated && !_finished) {
+        put(((_tick + 1 - _last_event) << 2) | dir_code(dir));
+        _last_event = _tick + 1;
+        _dir = dir;
+    }
+    _tick++;
+}
+
+void ReplayRecorder::end(int score)
+{
+    if (_finished) {
+        return;
+    }
+    put(0);
+    put(_tick);
+    put(score);
+    _finished = !_truncated;
+}
+
+void ReplayRecorder::put(uint32_t value)
+{
+    // worst case varint of 32 bits is 5 bytes
+    if (_size + 5 > REPLAY_BUFFER) {
+        _truncated = true;
+        return;
+    }
+    while (value >= 0x80) {
+        _buffer[_size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    _buffer[_size++] = value;
+}
+
+ReplayPlayer::ReplayPlayer()
+{
+    _data = 0;
+    _size = 0;
+    _pos = 0;
+    _seed = 1;
+    _mode = SnakeGame::classic_mode;
+    _tick = 0;
+    _last_event = 0;
+    _event_tick = NO_EVENT;
+    _event_dir = right;
+    _dir = right;
+    _total = 0;
+    _score = 0;
+}
+
+bool ReplayPlayer::load(const uint8_t *data, size_t size)
+{
+    _data = data;
+    _size = size;
+    _pos = 0;
+    _tick = 0;
+    _dir = right;
+    _total = 0;
+    _score = 0;
+
+    if (size < 2 || data[_pos++] != REPLAY_VERSION || !get(_seed)) {
+        _size = 0;
+        return false;
+    }
+    uint32_t fruits, walls, obstacles;
+    if (!get(fruits) || !get(walls) || !get(obstacles) ||
+        fruits < 1 || fruits > 0xFF || walls > 0xFF || obstacles > SNAKE_MAX_OBSTACLES) {
+        _size = 0;
+        return false;
+    }
+    _mode.fruits = fruits;
+    _mode.walls = walls;
+    _mode.obstacles = obstacles;
+
+    // the trailer sits after the events: find it once so done() is exact
+    size_t events = _pos;
+    uint32_t value;
+    while (get(value) && value != 0) {
+    }
+    uint32_t score = 0;
+    if (!get(_total) || !get(score)) {
+        _size = 0;
+        return false;
+    }
+    _score = score;
+
+    _pos = events;
+    _last_event = 0;
+    next_event();
+    return true;
+}
+
+directions ReplayPlayer::tick()
+{
+    if (_tick == _event_tick) {
+        _dir = _event_dir;
+        next_event();
+    }
+    _tick++;
+    return _dir;
+}
+
+void ReplayPlayer::next_event()
+{
+    uint32_t value;
+    if (!get(value) || value == 0) {
+        _event_tick = NO_EVENT;
+        return;
+    }
+    // deltas count from tick -1, i.e. _last_event is one past the event tick
+    _last_event += value >> 2;
+    _event_tick = _last_event - 1;
+    _event_dir = code_dirs[value & 0x3];
+}
+
+bool ReplayPlayer::get(uint32_t &value)
+{
+    value = 0;
+    for (uint8_t shift = 0; shift < 35 && _pos < _size; shift += 7) {
+        uint8_t byte = _data[_pos++];
+        value |= (uint32_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
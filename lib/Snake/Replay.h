@@ -0,0 +1,140 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Grabacion y reproduccion de partidas: semilla + cambios de direccion comprimidos
+*/
+
+#ifndef REPLAY_H_
+    #define REPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SnakeGame.h"
+
+    // Bytes reservados para grabar una partida
+    #define REPLAY_BUFFER 1024
+    #define REPLAY_VERSION 2
+
+/*
+ Log format, every number is an unsigned LEB128 varint:
+
+   REPLAY_VERSION (1 byte)
+   seed
+   GameMode: fruits, walls, obstacles
+   events: (ticks since the previous event << 2) | direction code, the
+           first event counting from tick -1 so the delta is never 0
+   0 (end marker), total ticks, final score
+
+ Direction codes: 0 up, 1 right, 2 down, 3 left. A game starts moving right
+ (SnakeGame::reset), so only turns are stored: a couple of bytes each.
+*/
+
+/**
+ * @brief Records the input of a game as it is played
+ * @details Call tick() once per game step with the direction about to be
+ * used; it only writes when the direction changed, so the cost per tick is a
+ * comparison. If the buffer fills up the log is marked as truncated and
+ * recording stops.
+ */
+class ReplayRecorder
+{
+public:
+    ReplayRecorder();
+
+    /**
+     * @brief starts a new log
+     *
+     * @param seed seed passed to SnakeGame::seed() for this game
+     * @param mode mode passed to SnakeGame::set_mode() for this game
+     */
+    void begin(uint32_t seed, const GameMode &mode);
+
+    /**
+     * @brief records one game step
+     *
+     * @param dir direction used for the step
+     */
+    void tick(directions dir);
+
+    /**
+     * @brief closes the log
+     *
+     * @param score final score, checked on playback
+     */
+    void end(int score);
+
+    const uint8_t *data() const { return _buffer; }
+    size_t size() const { return _size; }
+    bool finished() const { return _finished; }
+    bool truncated() const { return _truncated; }
+
+private:
+    void put(uint32_t value);
+
+    uint8_t _buffer[REPLAY_BUFFER];
+    size_t _size;
+    uint32_t _tick;
+    uint32_t _last_event; // one past the tick of the last event written
+    directions _dir;
+    bool _finished;
+    bool _truncated;
+};
+
+/**
+ * @brief Plays a recorded log back, one direction per game step
+ */
+class ReplayPlayer
+{
+public:
+    ReplayPlayer();
+
+    /**
+     * @brief opens a log, the data is not copied
+     *
+     * @return false if the log is not a valid REPLAY_VERSION log
+     */
+    bool load(const uint8_t *data, size_t size);
+
+    /**
+     * @brief seed to pass to SnakeGame::seed() before reset()
+     */
+    uint32_t seed() const { return _seed; }
+
+    /**
+     * @brief mode to pass to SnakeGame::set_mode() before reset()
+     */
+    const GameMode &mode() const { return _mode; }
+
+    /**
+     * @brief direction for the next game step
+     */
+    directions tick();
+
+    /**
+     * @brief true once every recorded step has been played
+     */
+    bool done() const { return _tick >= _total; }
+
+    uint32_t total_ticks() const { return _total; }
+    int score() const { return _score; }
+
+private:
+    bool get(uint32_t &value);
+    void next_event();
+
+    const uint8_t *_data;
+    size_t _size;
+    size_t _pos;
+    uint32_t _seed;
+    GameMode _mode;
+    uint32_t _tick;
+    uint32_t _last_event; // one past the tick of the last event read
+    uint32_t _event_tick; // tick of the pending event, 0xFFFFFFFF if none
+    directions _event_dir;
+    directions _dir;
+    uint32_t _total;
+    int _score;
+};
+
+#endif /* !REPLAY_H_ */
@@ -0,0 +1,322 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Cuerpo de la serpiente en celdas empaquetadas de 16 bits (o 2 bits por segmento)
+*/
+
+#ifndef SNAKEBODY_H_
+    #define SNAKEBODY_H_
+
+#include <stdint.h>
+
+    // Pantalla para la que se dimensiona el tablero por defecto
+    #ifndef SNAKE_SCREEN_WIDTH
+    #define SNAKE_SCREEN_WIDTH 84
+    #endif
+    #ifndef SNAKE_SCREEN_HEIGHT
+    #define SNAKE_SCREEN_HEIGHT 48
+    #endif
+
+    // Pixeles por lado de cada celda
+    #ifndef SNAKE_CELL
+    #define SNAKE_CELL 1
+    #endif
+
+    // Area de juego: celdas 1..SNAKE_WIDTH x 1..SNAKE_HEIGHT, el marco esta en 0 y en WIDTH+1/HEIGHT+1
+    #define SNAKE_WIDTH (SNAKE_SCREEN_WIDTH / SNAKE_CELL - 2)
+    #define SNAKE_HEIGHT (SNAKE_SCREEN_HEIGHT / SNAKE_CELL - 2)
+    #define SNAKE_CELLS (SNAKE_WIDTH * SNAKE_HEIGHT)
+
+    // Cuerpo: nunca puede ser mas largo que el numero de celdas
+    #define SNAKE_MAX_BODY SNAKE_CELLS
+    #define SNAKE_START_BODY 5
+
+    // Celdas empaquetadas, marco incluido: y * SNAKE_STRIDE + x
+    #define SNAKE_STRIDE (SNAKE_WIDTH + 2)
+    #define SNAKE_GRID_CELLS (SNAKE_STRIDE * (SNAKE_HEIGHT + 2))
+
+    // Con SNAKE_COMPACT_BODY el cuerpo guarda 2 bits por segmento en vez de 16
+    // (unos 950 bytes en vez de 7.5 KB), a cambio de no poder leer un segmento
+    // suelto sin recorrer los anteriores
+
+/**
+ * @brief a board cell packed in 16 bits, see SNAKE_STRIDE
+ */
+typedef uint16_t snake_cell;
+
+/**
+ * @brief position of a walk along the body, see BasicSnakeBody::begin()
+ */
+struct BodyCursor
+{
+    uint16_t index; // segment, 0 is next to the head
+    snake_cell cell;
+};
+
+/**
+ * @brief The snake's body on a W x H board, from the segment behind the head
+ * to the tail
+ * @details A ring of packed cells: the snake moves by adding a segment at
+ * the front and dropping the tail, both O(1) whatever its length. The board
+ * size is a template parameter, so the storage is sized at compile time.
+ *
+ * With SNAKE_COMPACT_BODY only the front and back cells are kept whole; in
+ * between every link is a 2 bit direction code (0 up, 1 right, 2 down,
+ * 3 left) from a segment to the next. Walking the body with begin()/next()
+ * costs the same either way, only at() has to walk.
+ */
+template <int W, int H>
+class BasicSnakeBody
+{
+public:
+    enum {
+        stride = W + 2,   // cells per row, frame included
+        max_body = W * H
+    };
+
+    static snake_cell cell_of(int x, int y) { return (snake_cell) (y * stride + x); }
+    static int cell_x(snake_cell cell) { return cell % stride; }
+    static int cell_y(snake_cell cell) { return cell / stride; }
+
+    BasicSnakeBody() { clear(); }
+
+    void clear();
+
+    /**
+     * @brief adds a segment in front, next to the current front
+     */
+    void push_front(snake_cell cell);
+
+    /**
+     * @brief drops the tail
+     *
+     * @return the cell the tail was on
+     */
+    snake_cell pop_back();
+
+    uint16_t size() const { return _size; }
+    snake_cell front() const;
+    snake_cell back() const;
+
+    /**
+     * @brief segment i, 0 is the front
+     */
+    snake_cell at(uint16_t i) const;
+
+    /**
+     * @brief starts a walk from the front; valid while index < size()
+     */
+    BodyCursor begin() const;
+
+    /**
+     * @brief moves the walk one segment toward the tail
+     */
+    void next(BodyCursor &cursor) const;
+
+private:
+    uint16_t _size;
+    uint16_t _first; // slot of the front segment (or of its link)
+
+#ifdef SNAKE_COMPACT_BODY
+    enum { slots = max_body };
+
+    uint8_t link(uint16_t i) const;
+    static int16_t link_step(uint8_t code);
+
+    snake_cell _front;
+    snake_cell _back;
+    // links between segments i and i + 1, four per byte
+    uint8_t _links[(slots + 3) / 4];
+#else
+    enum { slots = max_body + 1 };
+
+    snake_cell _cells[slots];
+#endif
+};
+
+typedef BasicSnakeBody<SNAKE_WIDTH, SNAKE_HEIGHT> SnakeBody;
+
+inline snake_cell snake_cell_of(int x, int y) { return SnakeBody::cell_of(x, y); }
+inline int snake_cell_x(snake_cell cell) { return SnakeBody::cell_x(cell); }
+inline int snake_cell_y(snake_cell cell) { return SnakeBody::cell_y(cell); }
+
+#ifdef SNAKE_COMPACT_BODY
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::clear()
+{
+    _size = 0;
+    _first = 0;
+    _front = 0;
+    _back = 0;
+}
+
+// cell offset of each direction code: up, right, down, left
+template <int W, int H>
+int16_t BasicSnakeBody<W, H>::link_step(uint8_t code)
+{
+    switch (code) {
+    case 0:
+        return -stride;
+    case 1:
+        return 1;
+    case 2:
+        return stride;
+    default:
+        return -1;
+    }
+}
+
+template <int W, int H>
+uint8_t BasicSnakeBody<W, H>::link(uint16_t i) const
+{
+    uint16_t slot = _first + i;
+    if (slot >= slots) {
+        slot -= slots;
+    }
+    return (_links[slot / 4] >> (2 * (slot % 4))) & 3;
+}
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::push_front(snake_cell cell)
+{
+    if (_size == 0) {
+        _front = cell;
+        _back = cell;
+        _size = 1;
+        return;
+    }
+
+    int16_t step = _front - cell;
+    uint8_t code = 0;
+    while (code < 3 && link_step(code) != step) {
+        code++;
+    }
+
+    _first = _first ? _first - 1 : slots - 1;
+    uint8_t shift = 2 * (_first % 4);
+    _links[_first / 4] = (_links[_first / 4] & ~(3 << shift)) | (code << shift);
+    _front = cell;
+    _size++;
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::pop_back()
+{
+    snake_cell tail = _back;
+    if (_size > 1) {
+        // the last link leads from the new back to the old one
+        _back -= link_step(link(_size - 2));
+    }
+    if (_size > 0) {
+        _size--;
+    }
+    return tail;
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::front() const
+{
+    return _front;
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::back() const
+{
+    return _back;
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::at(uint16_t i) const
+{
+    BodyCursor c = begin();
+    while (c.index < i) {
+        next(c);
+    }
+    return c.cell;
+}
+
+template <int W, int H>
+BodyCursor BasicSnakeBody<W, H>::begin() const
+{
+    BodyCursor c = {0, _front};
+    return c;
+}
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::next(BodyCursor &cursor) const
+{
+    if (cursor.index + 1 < _size) {
+        cursor.cell += link_step(link(cursor.index));
+    }
+    cursor.index++;
+}
+
+#else
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::clear()
+{
+    _size = 0;
+    _first = 0;
+}
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::push_front(snake_cell cell)
+{
+    _first = _first ? _first - 1 : slots - 1;
+    _cells[_first] = cell;
+    if (_size < slots) {
+        _size++;
+    }
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::pop_back()
+{
+    if (_size > 0) {
+        _size--;
+    }
+    return at(_size);
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::front() const
+{
+    return _cells[_first];
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::back() const
+{
+    return at(_size - 1);
+}
+
+template <int W, int H>
+snake_cell BasicSnakeBody<W, H>::at(uint16_t i) const
+{
+    uint16_t slot = _first + i;
+    if (slot >= slots) {
+        slot -= slots;
+    }
+    return _cells[slot];
+}
+
+template <int W, int H>
+BodyCursor BasicSnakeBody<W, H>::begin() const
+{
+    BodyCursor c = {0, _cells[_first]};
+    return c;
+}
+
+template <int W, int H>
+void BasicSnakeBody<W, H>::next(BodyCursor &cursor) const
+{
+    cursor.index++;
+    cursor.cell = at(cursor.index);
+}
+
+#endif
+
+#endif /* !SNAKEBODY_H_ */
@@ -0,0 +1,559 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Reglas del juego Snake, sin dependencias de hardware (se compila tambien en el host)
+*/
+
+#ifndef SNAKEGAME_H_
+    #define SNAKEGAME_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SnakeBody.h"
+#include "CellIndex.h"
+
+    // Posicion inicial de la cabeza (o el centro si el tablero es mas pequeno)
+    #define SNAKE_START_X 15
+    #define SNAKE_START_Y 15
+
+    // Velocidad (segundos por tick)
+    #define SNAKE_START_PERIOD 0.15f
+    #define SNAKE_PERIOD_STEP 0.005f
+    #define SNAKE_MIN_PERIOD 0.02f
+
+    // Obstaculos moviles como mucho en una partida, y ticks por paso (van mas
+    // despacio que la serpiente para poder esquivarlos)
+    #define SNAKE_MAX_OBSTACLES 16
+    #define SNAKE_OBSTACLE_TICKS 2
+
+enum state
+{
+    start, stop, run, pause
+};
+
+enum directions{ up=5, down=1, left=7, right=3, null=10};
+
+/**
+ * @brief what happened during a tick
+ */
+enum SnakeEvent {
+    snake_idle,    // game not running
+    snake_moved,
+    snake_ate,     // fruit eaten, period changed
+    snake_crashed, // wall, obstacle or body hit, game stopped
+    snake_won      // no fruit left and no free cell for one, game stopped
+};
+
+/**
+ * @brief difficulty curve: the tick period shrinks by `step` seconds for each
+ * fruit eaten, down to `min`
+ */
+struct SpeedCurve
+{
+    float start;
+    float step;
+    float min;
+};
+
+/**
+ * @brief what is on the board besides the snake; {1, 0, 0} is the classic game
+ */
+struct GameMode
+{
+    uint8_t fruits;    // fruits on the board at once, at least 1
+    uint8_t walls;     // wall cells placed at random
+    uint8_t obstacles; // moving cells, up to SNAKE_MAX_OBSTACLES
+};
+
+struct objeto
+{
+    int x;
+    int y;
+};
+
+/**
+ * @brief Game state and rules of Snake on a W x H board of CELL pixel cells
+ * @details Holds the snake, the fruits, walls and obstacles of the GameMode
+ * and the speed, and advances them one tick at a time. Drawing, sound and
+ * input stay with the caller, so the same rules run on the board and on the
+ * host tools.
+ *
+ * Everything but the snake lives in `map`, a BasicCellIndex: a cell lookup,
+ * the nearest fruit and drawing the cells of a type cost about the same with
+ * many fruits and obstacles as in the classic game. `fruit` is the fruit
+ * nearest to the head, what the autopilots aim for.
+ *
+ * The board size is a template parameter: the body and the occupancy bitmap
+ * are sized at compile time and the bounds checks compare with constants.
+ * CELL is only used by the caller to draw (see screen_x()); SnakeGame is the
+ * board that fills the default screen. The board needs at least
+ * SNAKE_START_BODY + 2 columns for the starting snake.
+ */
+template <int W, int H, int CELL = 1>
+class BasicSnakeGame
+{
+public:
+    typedef BasicSnakeBody<W, H> Body;
+
+    enum {
+        width = W,
+        height = H,
+        cell_size = CELL,
+        cells = W * H,
+        // the starting body lies to the left of the head and must fit too
+        start_x = (SNAKE_START_X <= W / 2) ? SNAKE_START_X
+                : (W / 2 > SNAKE_START_BODY) ? W / 2 : SNAKE_START_BODY + 1,
+        start_y = (SNAKE_START_Y <= H / 2) ? SNAKE_START_Y : H / 2
+    };
+
+    BasicSnakeGame();
+
+    /**
+     * @brief starts a new game: snake at the start position moving right,
+     * score 0, a new fruit and the starting speed
+     */
+    void reset();
+
+    /**
+     * @brief advances the game by one tick
+     *
+     * @return what happened during the tick
+     */
+    SnakeEvent step();
+
+    /**
+     * @brief changes the direction for the next tick, ignoring reversals
+     * @details A reversal is checked against the last move, not the last
+     * turn, so two quick turns within a tick can't send the head back into
+     * its neck.
+     *
+     * @param d new direction
+     */
+    void turn(directions d);
+
+    /**
+     * @brief adds a fruit on a random free cell
+     * @details When the random cell is taken the next free one after it is
+     * used, so the fruit never lands on the snake and the search ends after
+     * one pass over the occupancy bitmap.
+     *
+     * @return false if no free cell is left
+     */
+    bool set_fruit();
+
+    /**
+     * @brief seeds the generator used to place the fruit, so a game can be
+     * played again identically
+     *
+     * @param seed any value, 0 is replaced by 1
+     */
+    void seed(uint32_t seed);
+
+    /**
+     * @brief changes the difficulty curve, applied from the next reset()
+     */
+    void set_speed(const SpeedCurve &curve) { _curve = curve; }
+
+    /**
+     * @brief changes what is placed on the board, applied from the next reset()
+     */
+    void set_mode(const GameMode &mode) { _mode = mode; }
+
+    /**
+     * @brief checks whether moving onto a cell ends the game: it is taken by
+     * the body, a wall or an obstacle, or lies outside the playfield
+     *
+     * @param x column (1-W)
+     * @param y row (1-H)
+     */
+    bool occupied(int x, int y) const;
+
+    /**
+     * @brief what is on a cell
+     *
+     * @param x column (1-W)
+     * @param y row (1-H)
+     *
+     * @return a cell_type: cell_snake for the head and body, cell_wall
+     * outside the playfield
+     */
+    uint8_t cell(int x, int y) const;
+
+    /**
+     * @brief number of body segments behind the head
+     */
+    int length() const { return score + SNAKE_START_BODY; }
+
+    /**
+     * @brief body segment i, 0 is right behind the head
+     * @details For walking the whole body prefer body.begin()/body.next(),
+     * which stay cheap with SNAKE_COMPACT_BODY.
+     */
+    objeto segment(int i) const;
+
+    /**
+     * @brief last body segment
+     */
+    objeto tail() const;
+
+    /**
+     * @brief left pixel of a column on screen, the frame is cell 0
+     */
+    static int screen_x(int x) { return x * CELL; }
+
+    /**
+     * @brief top pixel of a row on screen, the frame is cell 0
+     */
+    static int screen_y(int y) { return y * CELL; }
+
+    objeto head;
+    objeto fruit; // nearest to the head, 0,0 when there is none
+    Body body;
+    BasicCellIndex<W, H> map; // fruits, walls and obstacles
+    int score;
+    float period;
+    directions dir;
+    state game_state;
+
+    static const SpeedCurve default_speed;
+    static const GameMode classic_mode;
+
+private:
+    void mark(int x, int y, bool value);
+    uint32_t random();
+    bool place(uint8_t type, objeto &pos);
+    void move_obstacles();
+    void aim();
+
+    SpeedCurve _curve;
+    GameMode _mode;
+    uint32_t _rng;
+    directions _moved; // direction of the last step
+
+    int _fruit_dist;    // steps from the head to `fruit`, -1 to search again
+    uint8_t _obstacles;
+    uint8_t _obstacle_wait; // ticks left before the obstacles step
+    objeto _obstacle[SNAKE_MAX_OBSTACLES];
+    directions _obstacle_dir[SNAKE_MAX_OBSTACLES];
+
+    // ocupacion del cuerpo, un bit por celda
+    uint32_t _occupied[(cells + 31) / 32];
+};
+
+typedef BasicSnakeGame<SNAKE_WIDTH, SNAKE_HEIGHT, SNAKE_CELL> SnakeGame;
+
+template <int W, int H, int CELL>
+const SpeedCurve BasicSnakeGame<W, H, CELL>::default_speed = {SNAKE_START_PERIOD, SNAKE_PERIOD_STEP, SNAKE_MIN_PERIOD};
+
+template <int W, int H, int CELL>
+const GameMode BasicSnakeGame<W, H, CELL>::classic_mode = {1, 0, 0};
+
+template <int W, int H, int CELL>
+BasicSnakeGame<W, H, CELL>::BasicSnakeGame()
+{
+    _curve = default_speed;
+    _mode = classic_mode;
+    _rng = 1;
+    _fruit_dist = -1;
+    _obstacles = 0;
+    _obstacle_wait = SNAKE_OBSTACLE_TICKS;
+    score = 0;
+    period = _curve.start;
+    dir = null;
+    _moved = null;
+    game_state = stop;
+    head.x = start_x;
+    head.y = start_y;
+    fruit.x = 0;
+    fruit.y = 0;
+    memset(_occupied, 0, sizeof(_occupied));
+}
+
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::reset()
+{
+    memset(_occupied, 0, sizeof(_occupied));
+
+    score = 0;
+    period = _curve.start;
+    dir = right;
+    _moved = right;
+    head.x = start_x;
+    head.y = start_y;
+    body.clear();
+    for (int i = length(); i >= 1; i--) {
+        body.push_front(Body::cell_of(head.x - i, head.y));
+        mark(head.x - i, head.y, true);
+    }
+
+    // walls and obstacles stay off the starting row, fruits go last so the
+    // classic game draws the same fruits as before
+    map.clear();
+    objeto pos;
+    for (int i = 0; i < _mode.walls; i++) {
+        if (!place(cell_wall, pos)) {
+            break;
+        }
+    }
+    _obstacles = 0;
+    _obstacle_wait = SNAKE_OBSTACLE_TICKS;
+    while (_obstacles < _mode.obstacles && _obstacles < SNAKE_MAX_OBSTACLES && place(cell_obstacle, pos)) {
+        static const directions dirs[4] = {up, right, down, left};
+        _obstacle[_obstacles] = pos;
+        _obstacle_dir[_obstacles] = dirs[random() % 4];
+        _obstacles++;
+    }
+    int fruits = _mode.fruits ? _mode.fruits : 1;
+    for (int i = 0; i < fruits; i++) {
+        set_fruit();
+    }
+    aim();
+    game_state = run;
+}
+
+template <int W, int H, int CELL>
+SnakeEvent BasicSnakeGame<W, H, CELL>::step()
+{
+    if (game_state != run || dir == null) {
+        return snake_idle;
+    }
+
+    // the body follows the head: the old head becomes the first segment and
+    // the tail is dropped below unless the snake grows this tick
+    body.push_front(Body::cell_of(head.x, head.y));
+    mark(head.x, head.y, true);
+
+    switch (dir) {
+    case up:
+        head.y -= 1;
+        break;
+    case down:
+        head.y += 1;
+        break;
+    case left:
+        head.x -= 1;
+        break;
+    case right:
+        head.x += 1;
+        break;
+    default:
+        break;
+    }
+    _moved = dir;
+
+    bool ate = map.get(head.x, head.y) == cell_fruit;
+
+    // the tail moves away unless the snake grows this tick
+    if (!ate) {
+        snake_cell tail = body.pop_back();
+        mark(Body::cell_x(tail), Body::cell_y(tail), false);
+    }
+
+    // Crashed
+    if (head.x < 1 || head.x > W || head.y < 1 || head.y > H) {
+        game_state = stop;
+        return snake_crashed;
+    }
+
+    // Game Over
+    if (occupied(head.x, head.y)) {
+        game_state = stop;
+        return snake_crashed;
+    }
+
+    // Eat the mouse
+    if (ate) {
+        score += 1;
+        period -= _curve.step;
+        if (period < _curve.min) {
+            period = _curve.min;
+        }
+        map.set(head.x, head.y, cell_empty);
+        if (!set_fruit() && !map.count(cell_fruit)) {
+            fruit.x = 0;
+            fruit.y = 0;
+            game_state = stop;
+            return snake_won;
+        }
+    }
+
+    move_obstacles();
+    aim();
+    return ate ? snake_ate : snake_moved;
+}
+
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::turn(directions d)
+{
+    if ((d == up && _moved != down) ||
+        (d == down && _moved != up) ||
+        (d == left && _moved != right) ||
+        (d == right && _moved != left)) {
+        dir = d;
+    }
+}
+
+template <int W, int H, int CELL>
+objeto BasicSnakeGame<W, H, CELL>::segment(int i) const
+{
+    snake_cell cell = body.at(i);
+    objeto pos = {Body::cell_x(cell), Body::cell_y(cell)};
+    return pos;
+}
+
+template <int W, int H, int CELL>
+objeto BasicSnakeGame<W, H, CELL>::tail() const
+{
+    snake_cell cell = body.back();
+    objeto pos = {Body::cell_x(cell), Body::cell_y(cell)};
+    return pos;
+}
+
+template <int W, int H, int CELL>
+bool BasicSnakeGame<W, H, CELL>::set_fruit()
+{
+    objeto pos;
+    if (!place(cell_fruit, pos)) {
+        return false;
+    }
+    fruit = pos;
+    _fruit_dist = -1; // the new fruit may be nearer
+    return true;
+}
+
+// a random free cell, or the next free one after it; walls and obstacles
+// also keep off the starting row
+template <int W, int H, int CELL>
+bool BasicSnakeGame<W, H, CELL>::place(uint8_t type, objeto &pos)
+{
+    unsigned int x = random() % W;
+    unsigned int y = random() % H;
+    unsigned int cell = y * W + x;
+    unsigned int head_cell = (head.y - 1) * W + (head.x - 1);
+
+    for (int left = cells; left > 0;) {
+        // a word of body cells is skipped at once; the unused bits of the
+        // last word are 0, so it is never skipped past the end
+        if (cell % 32 == 0 && _occupied[cell / 32] == 0xFFFFFFFFUL) {
+            cell = (cell + 32) % cells;
+            left -= 32;
+            continue;
+        }
+        if (!(_occupied[cell / 32] & (1UL << (cell % 32))) && cell != head_cell) {
+            pos.x = cell % W + 1;
+            pos.y = cell / W + 1;
+            if (map.get(pos.x, pos.y) == cell_empty && (type == cell_fruit || pos.y != start_y)) {
+                map.set(pos.x, pos.y, type);
+                return true;
+            }
+        }
+        cell = (cell + 1) % cells;
+        left--;
+    }
+    return false;
+}
+
+// every SNAKE_OBSTACLE_TICKS ticks each obstacle steps into a free cell, or
+// turns back when something is there
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::move_obstacles()
+{
+    if (--_obstacle_wait) {
+        return;
+    }
+    _obstacle_wait = SNAKE_OBSTACLE_TICKS;
+    for (uint8_t i = 0; i < _obstacles; i++) {
+        objeto &o = _obstacle[i];
+        directions d = _obstacle_dir[i];
+        int x = o.x + (d == right) - (d == left);
+        int y = o.y + (d == down) - (d == up);
+        if (cell(x, y) != cell_empty) {
+            _obstacle_dir[i] = (directions) ((d + 4) % 8); // opposite points are 4 apart
+            continue;
+        }
+        map.set(o.x, o.y, cell_empty);
+        map.set(x, y, cell_obstacle);
+        o.x = x;
+        o.y = y;
+    }
+}
+
+// fruit follows the fruit nearest to the head; with a single fruit it is
+// the one set_fruit() placed
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::aim()
+{
+    uint16_t fruits = map.count(cell_fruit);
+    if (!fruits) {
+        fruit.x = 0;
+        fruit.y = 0;
+        return;
+    }
+    if (fruits == 1 && map.get(fruit.x, fruit.y) == cell_fruit) {
+        return;
+    }
+
+    // a step brings the head at most one closer to any fruit, so if it got
+    // closer to the nearest one, that one is still the nearest
+    int dist = abs(fruit.x - head.x) + abs(fruit.y - head.y);
+    if (_fruit_dist >= 0 && dist < _fruit_dist && map.get(fruit.x, fruit.y) == cell_fruit) {
+        _fruit_dist = dist;
+        return;
+    }
+    map.nearest(cell_fruit, head.x, head.y, fruit.x, fruit.y);
+    _fruit_dist = abs(fruit.x - head.x) + abs(fruit.y - head.y);
+}
+
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::seed(uint32_t seed)
+{
+    _rng = seed ? seed : 1;
+}
+
+// xorshift32: small, fast and the same on the board and on the host
+template <int W, int H, int CELL>
+uint32_t BasicSnakeGame<W, H, CELL>::random()
+{
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return _rng;
+}
+
+template <int W, int H, int CELL>
+bool BasicSnakeGame<W, H, CELL>::occupied(int x, int y) const
+{
+    if (x < 1 || x > W || y < 1 || y > H) {
+        return true;
+    }
+    unsigned int cell = (y - 1) * W + (x - 1);
+    return (_occupied[cell / 32] & (1UL << (cell % 32))) || map.get(x, y) >= cell_wall;
+}
+
+template <int W, int H, int CELL>
+uint8_t BasicSnakeGame<W, H, CELL>::cell(int x, int y) const
+{
+    if (x < 1 || x > W || y < 1 || y > H) {
+        return cell_wall;
+    }
+    unsigned int cell = (y - 1) * W + (x - 1);
+    if ((x == head.x && y == head.y) || (_occupied[cell / 32] & (1UL << (cell % 32)))) {
+        return cell_snake;
+    }
+    return map.get(x, y);
+}
+
+template <int W, int H, int CELL>
+void BasicSnakeGame<W, H, CELL>::mark(int x, int y, bool value)
+{
+    unsigned int cell = (y - 1) * W + (x - 1);
+    if (value) {
+        _occupied[cell / 32] |= 1UL << (cell % 32);
+    } else {
+        _occupied[cell / 32] &= ~(1UL << (cell % 32));
+    }
+}
+
+#endif /* !SNAKEGAME_H_ */
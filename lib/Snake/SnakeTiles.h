@@ -0,0 +1,30 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Atlas de tiles 4x4 para dibujar la serpiente con TileMap
+*/
+
+#ifndef SNAKETILES_H_
+    #define SNAKETILES_H_
+
+#include <stdint.h>
+
+    // Indices en el atlas: los cinco primeros en el orden de los tipos de
+    // celda (CellPlane.h), asi SnakeGame::cell() da directamente el tile
+    enum snake_tile{ tile_empty, tile_fruit, tile_wall, tile_obstacle, tile_body,
+                     tile_head, tile_frame};
+    #define SNAKE_TILE_SIZE 4
+
+    // Un byte por columna, bit 0 arriba; solo se usa el nibble bajo
+    static const uint8_t snake_tiles[] = {
+        0x0, 0x0, 0x0, 0x0, // vacio
+        0x4, 0xA, 0xA, 0x4, // fruta: anillo
+        0xF, 0x9, 0x9, 0xF, // muro: caja
+        0x9, 0x6, 0x6, 0x9, // obstaculo: aspa
+        0x0, 0x6, 0x6, 0x0, // cuerpo: cuadrado 2x2 con separacion
+        0x6, 0xF, 0xF, 0x6, // cabeza: circulo lleno
+        0xF, 0xF, 0xF, 0xF, // marco: lleno, como el de board_layer
+    };
+
+#endif /* !SNAKETILES_H_ */
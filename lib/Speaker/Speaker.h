@@ -13,7 +13,7 @@
 class Speaker
 {
 public:
-    Speaker(PinName pin) : _pin(pin) {
+    Speaker(PinName pin) : _pin(pin), _next_duration(0) {
 // _pin(pin) means pass pin to the Speaker Constructor
     }
 // class method to play a note based on PwmOut class
@@ -23,9 +23,33 @@ public:
         wait(duration);
         _pin = 0.0;
     }
+// same note without blocking: a Timeout silences it after `duration`
+    void StartNote(float frequency, float duration, float volume) {
+        _next_duration = 0;
+        _pin.period(1.0/frequency);
+        _pin = volume/2.0;
+        _stop.attach(callback(this, &Speaker::Stop), duration);
+    }
+// note to play when the one started ends, without blocking either; only one waits
+    void QueueNote(float frequency, float duration, float volume) {
+        _next_frequency = frequency;
+        _next_volume = volume;
+        _next_duration = duration;
+    }
+// silences the speaker or starts the queued note, also from an ISR
+    void Stop() {
+        _pin = 0.0;
+        if (_next_duration > 0) {
+            StartNote(_next_frequency, _next_duration, _next_volume);
+        }
+    }
  
 private:
     PwmOut _pin;
+    Timeout _stop;
+    float _next_frequency;
+    float _next_volume;
+    volatile float _next_duration; // 0 when no note waits
 };
 
 #endif /* !SPEAKER_H_ */
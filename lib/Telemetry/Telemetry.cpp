@@ -0,0 +1,126 @@
+#include "Telemetry.h"
+
+#define RING_MASK (TELEMETRY_BUFFER - 1)
+
+Telemetry::Telemetry(PinName tx, PinName rx, int baud) : _serial(tx, rx, baud)
+{
+    _head = 0;
+    _tail = 0;
+    _tx_active = false;
+    _dropped = 0;
+}
+
+bool Telemetry::write(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+    if (len > TELEMETRY_MAX_PAYLOAD) {
+        return false;
+    }
+
+    uint8_t sum = type + len;
+    for (uint8_t i = 0; i < len; i++) {
+        sum += payload[i];
+    }
+
+    core_util_critical_section_enter();
+
+    uint16_t used = (_head - _tail) & RING_MASK;
+    // one slot stays empty so a full ring is distinguishable from an empty one
+    if (used + TELEMETRY_HEADER + len + 1 > RING_MASK) {
+        _dropped++;
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    uint16_t head = _head;
+    _ring[head] = TELEMETRY_SYNC;
+    head = (head + 1) & RING_MASK;
+    _ring[head] = type;
+    head = (head + 1) & RING_MASK;
+    _ring[head] = len;
+    head = (head + 1) & RING_MASK;
+    for (uint8_t i = 0; i < len; i++) {
+        _ring[head] = payload[i];
+        head = (head + 1) & RING_MASK;
+    }
+    _ring[head] = (uint8_t) -sum;
+    _head = (head + 1) & RING_MASK;
+
+    if (!_tx_active) {
+        // the TX register is empty, so the interrupt fires straight away
+        _tx_active = true;
+        _serial.attach(callback(this, &Telemetry::tx_isr), RawSerial::TxIrq);
+    }
+
+    core_util_critical_section_exit();
+    return true;
+}
+
+bool Telemetry::log_tick(uint16_t score, uint16_t tick_us, uint16_t frame_bytes, uint16_t latency_us)
+{
+    TickRecord rec;
+    rec.score = score;
+    rec.tick_us = tick_us;
+    rec.frame_bytes = frame_bytes;
+    rec.latency_us = latency_us;
+
+    uint8_t payload[TICK_RECORD_SIZE];
+    tick_record_pack(rec, payload);
+    return write(telemetry_tick, payload, TICK_RECORD_SIZE);
+}
+
+bool Telemetry::log_boot(uint32_t lcd_us, uint32_t frame_us)
+{
+    BootRecord rec;
+    rec.lcd_us = lcd_us;
+    rec.frame_us = frame_us;
+
+    uint8_t payload[BOOT_RECORD_SIZE];
+    boot_record_pack(rec, payload);
+    return write(telemetry_boot, payload, BOOT_RECORD_SIZE);
+}
+
+bool Telemetry::log_replay(const uint8_t *log, uint16_t size, uint16_t &offset)
+{
+    if (offset >= size) {
+        return true;
+    }
+
+    uint8_t len = (size - offset > REPLAY_CHUNK) ? REPLAY_CHUNK : size - offset;
+    uint16_t header = offset | ((offset + len == size) ? REPLAY_LAST_CHUNK : 0);
+
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+    payload[0] = header & 0xFF;
+    payload[1] = header >> 8;
+    memcpy(payload + 2, log + offset, len);
+
+    // a full ring is not an error here, the caller tries again later
+    core_util_critical_section_enter();
+    uint32_t dropped = _dropped;
+    bool queued = write(telemetry_replay, payload, len + 2);
+    _dropped = dropped;
+    core_util_critical_section_exit();
+
+    if (queued) {
+        offset += len;
+    }
+    return offset >= size;
+}
+
+uint32_t Telemetry::dropped()
+{
+    return _dropped;
+}
+
+void Telemetry::tx_isr()
+{
+    while (_tail != _head && _serial.writeable()) {
+        _serial.putc(_ring[_tail]);
+        _tail = (_tail + 1) & RING_MASK;
+    }
+
+    if (_tail == _head) {
+        // nothing left, stop the interrupt until the next write()
+        _serial.attach(Callback<void()>(), RawSerial::TxIrq);
+        _tx_active = false;
+    }
+}
@@ -0,0 +1,92 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Canal de telemetria por UART con buffer circular y envio por interrupcion
+*/
+
+#ifndef TELEMETRY_H_
+    #define TELEMETRY_H_
+
+#include <mbed.h>
+#include "TelemetryRecord.h"
+
+// bytes queued for transmission, must be a power of two no bigger than 256
+#define TELEMETRY_BUFFER 256
+
+#define TELEMETRY_BAUD 115200
+
+/**
+ * @brief Non blocking telemetry over a UART
+ * @details Records are framed (see TelemetryRecord.h) and copied into a ring
+ * buffer; the transmit interrupt drains it in the background, so logging only
+ * costs the copy. When the ring is full the record is dropped and counted
+ * instead of blocking the caller. Safe to call from ISRs (e.g. Ticker
+ * callbacks).
+ *
+ * Decode the stream on the host with tools/telemetry_decode.cpp.
+ */
+class Telemetry
+{
+public:
+    /**
+     * @brief constructor
+     *
+     * @param tx UART transmit pin
+     * @param rx UART receive pin
+     * @param baud baud rate
+     */
+    Telemetry(PinName tx, PinName rx, int baud = TELEMETRY_BAUD);
+
+    /**
+     * @brief queues a framed record
+     *
+     * @param type record type (see TelemetryType)
+     * @param payload payload bytes
+     * @param len payload length, up to TELEMETRY_MAX_PAYLOAD
+     *
+     * @return false if the record was dropped
+     */
+    bool write(uint8_t type, const uint8_t *payload, uint8_t len);
+
+    /**
+     * @brief queues a telemetry_tick record
+     */
+    bool log_tick(uint16_t score, uint16_t tick_us, uint16_t frame_bytes, uint16_t latency_us);
+
+    /**
+     * @brief queues a telemetry_boot record
+     */
+    bool log_boot(uint32_t lcd_us, uint32_t frame_us);
+
+    /**
+     * @brief queues the next telemetry_replay chunk of a replay log
+     * @details Call again (e.g. once per tick) until it returns true; a chunk
+     * that does not fit in the ring is simply retried on the next call.
+     *
+     * @param log replay log
+     * @param size log size in bytes
+     * @param offset bytes already sent, advanced when a chunk is queued
+     *
+     * @return true once the whole log has been queued
+     */
+    bool log_replay(const uint8_t *log, uint16_t size, uint16_t &offset);
+
+    /**
+     * @brief number of records dropped because the ring was full
+     */
+    uint32_t dropped();
+
+private:
+    void tx_isr();
+
+    RawSerial _serial;
+
+    uint8_t _ring[TELEMETRY_BUFFER];
+    volatile uint16_t _head; // next byte to write
+    volatile uint16_t _tail; // next byte to send
+    volatile bool _tx_active;
+    volatile uint32_t _dropped;
+};
+
+#endif /* !TELEMETRY_H_ */
@@ -0,0 +1,189 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Formato binario de los registros de telemetria (compartido con las herramientas de host)
+*/
+
+#ifndef TELEMETRYRECORD_H_
+    #define TELEMETRYRECORD_H_
+
+#include <stdint.h>
+
+/*
+ Every record travels as one frame:
+
+   offset | size | field
+   -------+------+---------------------------------------------
+      0   |  1   | TELEMETRY_SYNC
+      1   |  1   | record type (see TelemetryType)
+      2   |  1   | payload length n
+      3   |  n   | payload, multi-byte fields little endian
+     3+n  |  1   | checksum: two's complement of type + n + payload
+
+ The host re-synchronises on TELEMETRY_SYNC and drops frames whose
+ checksum does not add up to zero.
+*/
+#define TELEMETRY_SYNC 0xA5
+#define TELEMETRY_HEADER 3
+#define TELEMETRY_MAX_PAYLOAD 32
+#define TELEMETRY_MAX_FRAME (TELEMETRY_HEADER + TELEMETRY_MAX_PAYLOAD + 1)
+
+enum TelemetryType {
+    telemetry_tick = 0x01,
+    telemetry_replay = 0x02, // chunk of a replay log, see below
+    telemetry_boot = 0x03    // once at startup
+};
+
+/**
+ * @brief payload of a telemetry_tick record, one per game tick
+ */
+struct TickRecord {
+    uint16_t score;       // score after the tick
+    uint16_t tick_us;     // time spent inside the tick handler
+    uint16_t frame_bytes; // bytes pushed to the display during the tick
+    uint16_t latency_us;  // joystick change to applied move, 0 if none
+};
+
+#define TICK_RECORD_SIZE 8
+
+/**
+ * @brief serialises a tick record into its little endian payload
+ *
+ * @param rec record to pack
+ * @param out buffer of at least TICK_RECORD_SIZE bytes
+ */
+inline void tick_record_pack(const TickRecord &rec, uint8_t *out) {
+    out[0] = rec.score & 0xFF;
+    out[1] = rec.score >> 8;
+    out[2] = rec.tick_us & 0xFF;
+    out[3] = rec.tick_us >> 8;
+    out[4] = rec.frame_bytes & 0xFF;
+    out[5] = rec.frame_bytes >> 8;
+    out[6] = rec.latency_us & 0xFF;
+    out[7] = rec.latency_us >> 8;
+}
+
+/**
+ * @brief reads a tick record back from its payload
+ *
+ * @param in payload of TICK_RECORD_SIZE bytes
+ * @param rec record to fill
+ */
+inline void tick_record_unpack(const uint8_t *in, TickRecord &rec) {
+    rec.score = in[0] | (in[1] << 8);
+    rec.tick_us = in[2] | (in[3] << 8);
+    rec.frame_bytes = in[4] | (in[5] << 8);
+    rec.latency_us = in[6] | (in[7] << 8);
+}
+
+/**
+ * @brief payload of a telemetry_boot record, times since main() started
+ */
+struct BootRecord {
+    uint32_t lcd_us;   // display reset and configured
+    uint32_t frame_us; // first frame on screen, input accepted from here
+};
+
+#define BOOT_RECORD_SIZE 8
+
+inline void boot_record_pack(const BootRecord &rec, uint8_t *out) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (rec.lcd_us >> (8 * i)) & 0xFF;
+        out[4 + i] = (rec.frame_us >> (8 * i)) & 0xFF;
+    }
+}
+
+inline void boot_record_unpack(const uint8_t *in, BootRecord &rec) {
+    rec.lcd_us = 0;
+    rec.frame_us = 0;
+    for (int i = 0; i < 4; i++) {
+        rec.lcd_us |= (uint32_t) in[i] << (8 * i);
+        rec.frame_us |= (uint32_t) in[4 + i] << (8 * i);
+    }
+}
+
+/*
+ telemetry_replay payload: offset of the chunk in the log (16 bits, little
+ endian, REPLAY_LAST_CHUNK set on the final chunk) followed by up to
+ REPLAY_CHUNK bytes of the log written by ReplayRecorder.
+*/
+#define REPLAY_CHUNK (TELEMETRY_MAX_PAYLOAD - 2)
+#define REPLAY_LAST_CHUNK 0x8000
+
+/**
+ * @brief clamps a microsecond count to the 16 bit record fields
+ */
+inline uint16_t telemetry_us16(uint32_t us) {
+    return us > 0xFFFF ? 0xFFFF : (uint16_t) us;
+}
+
+/**
+ * @brief incremental frame decoder, fed one byte at a time
+ */
+class TelemetryParser {
+public:
+    TelemetryParser() : _state(0), _len(0), _pos(0), _sum(0), _type(0), _errors(0) {}
+
+    /**
+     * @brief feeds one received byte
+     *
+     * @return true when a complete, valid frame is available in type() and
+     * payload()
+     */
+    bool feed(uint8_t byte) {
+        switch (_state) {
+        case 0: // waiting for sync
+            if (byte == TELEMETRY_SYNC) {
+                _state = 1;
+            }
+            return false;
+        case 1: // type
+            _type = byte;
+            _sum = byte;
+            _state = 2;
+            return false;
+        case 2: // length
+            if (byte > TELEMETRY_MAX_PAYLOAD) {
+                _errors++;
+                _state = 0;
+                return false;
+            }
+            _len = byte;
+            _pos = 0;
+            _sum += byte;
+            _state = _len ? 3 : 4;
+            return false;
+        case 3: // payload
+            _payload[_pos++] = byte;
+            _sum += byte;
+            if (_pos == _len) {
+                _state = 4;
+            }
+            return false;
+        default: // checksum
+            _state = 0;
+            if ((uint8_t) (_sum + byte) != 0) {
+                _errors++;
+                return false;
+            }
+            return true;
+        }
+    }
+
+    uint8_t type() const { return _type; }
+    uint8_t length() const { return _len; }
+    const uint8_t *payload() const { return _payload; }
+    unsigned long errors() const { return _errors; }
+
+private:
+    uint8_t _state;
+    uint8_t _len;
+    uint8_t _pos;
+    uint8_t _sum;
+    uint8_t _type;
+    unsigned long _errors;
+    uint8_t _payload[TELEMETRY_MAX_PAYLOAD];
+};
+
+#endif /* !TELEMETRYRECORD_H_ */
@@ -2,203 +2,382 @@
 #include <mbed.h>
 #include "main.h"
 #include <Nokia5110.h>
+#include <DisplayList.h>
+#include <NumberField.h>
+#include <TileMap.h>
 #include <Joystick.h>
 #include <Speaker.h>
+#include <Telemetry.h>
+#include <SnakeGame.h>
+#include <Replay.h>
+#include <Autopilot.h>
+#include <Hamiltonian.h>
+#include <SnakeTiles.h>
 
 // Salidas a pins
 Nokia5110 display(D8,D9,D12,D11,D13);
 Joystick joystick(A0,A2,D2);
 Speaker mySpeaker(D6);
+Telemetry telemetry(USBTX, USBRX);
 
-// Ticker
+// Pantallas fijas, dibujadas una sola vez al arrancar
+DisplayList board_list;
+DisplayList gameover_list;
+DisplayList pause_list;
+lcd_layer_t board_layer;    // marco del tablero
+lcd_layer_t gameover_layer; // textos del GameOver
+lcd_layer_t pause_layer;    // texto de pausa, se compone sobre el marco
+NumberField score_field(display, 30, 35, 4); // puntuacion bajo los textos
+
+// Con celdas del tamano de un tile (-DSNAKE_CELL=4) el tablero se dibuja con
+// TileMap: cada tipo de celda tiene su dibujo y solo se redibujan las celdas
+// que cambian. Con celdas mas pequenas todas son un cuadrado lleno.
+#if SNAKE_CELL == SNAKE_TILE_SIZE
+TileMap board_tiles(display, snake_tiles, SNAKE_TILE_SIZE);
+#define RAM_BOARD_TILES sizeof(TileMap)
+#else
+#define RAM_BOARD_TILES 0
+#endif
+bool board_redraw = true; // el buffer tiene otra pantalla: redibujar todo el tablero
+
+// Ticker: las interrupciones solo levantan banderas, el trabajo se hace en
+// el bucle principal y entre eventos el micro duerme
 Ticker move;
+Ticker sampler;
+volatile bool tick_due = false;   // toca avanzar el juego
+volatile bool sample_due = false; // toca leer el joystick
+bool lcd_on = true;
+
+// Presentacion sin bloqueo: un Ticker marca los pasos, cada paso dibuja un
+// cuadro y lanza su nota sin esperar; el bucle principal sigue leyendo el
+// joystick, asi que tocarlo salta la presentacion
+Ticker intro;
+volatile bool intro_due = false;
+int intro_left = -1;             // siguiente paso, -1 si no hay presentacion
+void (*intro_frame)(int) = NULL; // dibuja el paso j, el ultimo es j=0
+
+// Telemetria
+Timer clock_us;
+// Los instantes son uint32_t: read_us() da la vuelta a los 35 minutos y la
+// resta sin signo sigue siendo correcta
+bool input_pending = false; // hay un cambio de direccion sin aplicar
+uint32_t input_us = 0;      // instante de ese cambio
+int frame_bytes = 0;        // bytes enviados a la pantalla en el tick
 
 // Variables de control
-int score = 0;
-float fps=0.15;
-enum state
-{       
-    start, stop, run, pause
-};
-enum directions{ up=5, down=1, left=7, right=3, null=10};
-directions MovDir;
-state game_state;
-int map[MAX_WIDTH][MAX_HEIGHT]; //si 0=vacio, 1=fruta, 2=muro
-//int fruit_pos[0][0];
-//int _pos[0][0];
-
-// Clases
-struct objeto
-{
-    int x;
-    int y;
-};
-
-struct objeto head;
-struct objeto fruit;
-struct objeto wall;
-objeto* corp = new objeto[3000];
+SnakeGame game;
+Autopilot pilot;
+HamiltonianPilot perfect;
+ReplayRecorder recorder;  // entradas de la partida en curso
+ReplayPlayer replay;
+uint16_t replay_sent = 0; // bytes del registro ya enviados por telemetria
+enum pilot_mode{ pilot_off, pilot_search, pilot_cycle, pilot_replay};
+pilot_mode autopilot = pilot_off; // modo demo: la serpiente juega sola
+int demo_hold = 0;       // ticks mostrando GameOver antes de reiniciar la demo
+const GameMode play_mode = {PLAY_FRUITS, PLAY_WALLS, PLAY_OBSTACLES};
+
+// Memoria fija: nada se reserva en tiempo de ejecucion, todo esta aqui
+MBED_STATIC_ASSERT(sizeof(Nokia5110) <= RAM_DISPLAY, "Nokia5110 over its RAM budget");
+MBED_STATIC_ASSERT(sizeof(Joystick) <= RAM_JOYSTICK, "Joystick over its RAM budget");
+MBED_STATIC_ASSERT(sizeof(SnakeGame) <= RAM_GAME, "SnakeGame over its RAM budget");
+MBED_STATIC_ASSERT(sizeof(Autopilot) + sizeof(HamiltonianPilot) <= RAM_PILOTS,
+                   "autopilots over their RAM budget");
+MBED_STATIC_ASSERT(3 * (sizeof(DisplayList) + sizeof(lcd_layer_t)) + sizeof(NumberField) +
+                   RAM_BOARD_TILES <= RAM_SCREENS,
+                   "baked screens over their RAM budget");
+MBED_STATIC_ASSERT(sizeof(Nokia5110) + sizeof(Joystick) + sizeof(Speaker) + sizeof(Telemetry) +
+                   sizeof(SnakeGame) + sizeof(Autopilot) + sizeof(HamiltonianPilot) +
+                   sizeof(ReplayRecorder) + sizeof(ReplayPlayer) +
+                   3 * (sizeof(DisplayList) + sizeof(lcd_layer_t)) + sizeof(NumberField) +
+                   RAM_BOARD_TILES <= RAM_TOTAL,
+                   "globals over the RAM budget");
 
 // Funciones
-//Fruta
-void SetFruit(){
-    fruit.x = rand()%MAX_WIDTH+1;
-    fruit.y = rand()%MAX_HEIGHT+1;
-    map[fruit.x][fruit.y] = 1;
-    /*if(map[fruit.x][fruit.y] == 2){
-        SetFruit();
-    }*/
-    
+void TickISR(){
+    tick_due = true;
+}
+
+void SampleISR(){
+    sample_due = true;
+}
+
+void IntroISR(){
+    intro_due = true;
+}
+
+// Arranca una presentacion de steps+1 pasos; el primero se dibuja ya
+void StartIntro(void (*frame)(int), int steps, float period){
+    intro_frame = frame;
+    intro_left = steps;
+    intro_due = true;
+    intro.attach(&IntroISR, period);
 }
-//wall
-void SetWall(){
-    wall.x = rand()%MAX_WIDTH+1;
-    wall.y = rand()%MAX_HEIGHT+1;
-    map[wall.x][wall.y] = 1;
-    if(map[wall.x][wall.y] == 2){
-        SetWall();
+
+void StopIntro(){
+    intro.detach();
+    intro_due = false;
+    intro_left = -1;
+}
+
+void IntroStep(){
+    intro_due = false;
+    if(intro_left < 0){
+        return;
+    }
+    intro_frame(intro_left--);
+    if(intro_left < 0){
+        intro.detach();
     }
 }
 
-// Direcciones
-void up_Dir(){
-    if(MovDir != down){
-        MovDir = up;
+// Duerme hasta la siguiente interrupcion si no hay nada pendiente. Las
+// banderas se miran con las interrupciones apagadas para no perder un evento
+// entre la comprobacion y el sleep; una interrupcion pendiente despierta igual.
+void WaitEvent(){
+    __disable_irq();
+    if(!tick_due && !sample_due && !intro_due){
+        sleep();
     }
+    __enable_irq();
+}
+
+// Apaga la pantalla y para el juego hasta que se toque el joystick
+void PowerDown(){
+    move.detach();
+    tick_due = false;
+    autopilot = pilot_off;
+    display.set_power(0);
+    lcd_on = false;
+    sampler.attach(&SampleISR, JOY_SLEEP_PERIOD);
 }
 
-void down_Dir(){
-    if(MovDir != up){
-        MovDir = down;
+void PowerUp(){
+    display.set_power(1);
+    lcd_on = true;
+    sampler.attach(&SampleISR, JOY_SAMPLE_PERIOD);
+}
+
+void GameTick();
+
+// Nueva partida: semilla conocida para poder repetirla
+void NewGame(){
+    move.detach();
+    uint32_t seed = clock_us.read_us();
+    // el ciclo hamiltoniano solo sirve en el tablero sin muros
+    GameMode mode = autopilot == pilot_cycle ? SnakeGame::classic_mode : play_mode;
+    if(autopilot == pilot_replay){
+        seed = replay.seed();
+        mode = replay.mode(); // el modo con el que se grabo
+    }else{
+        recorder.begin(seed, mode);
+        replay_sent = 0;
     }
+    game.set_mode(mode);
+    game.seed(seed);
+    game.reset();
+    pilot.reset();
+    board_redraw = true;
+    move.attach(&TickISR, game.period);
 }
 
-void left_Dir(){
-    if(MovDir != right){
-        MovDir = left;
+void GameOver(){
+    display.load_buffer(gameover_layer);
+    score_field.invalidate();
+    score_field.set(game.score);
+    frame_bytes += display.display();
+}
+
+// Una celda del tablero; con celdas de un pixel es un draw_pixel
+void DrawCell(int x, int y){
+    if(SnakeGame::cell_size == 1){
+        display.draw_pixel(x,y,1);
+    }else{
+        display.fill_rect(SnakeGame::screen_x(x), SnakeGame::screen_y(y),
+                          SnakeGame::screen_x(x+1)-1, SnakeGame::screen_y(y+1)-1);
     }
 }
 
-void right_Dir(){
-    if(MovDir != left){
-        MovDir = right;
+// Todas las celdas de un tipo; el indice del mapa salta las filas vacias
+void DrawCells(uint8_t type){
+    if(game.map.count(type) == 0){
+        return;
+    }
+    for(int y=1;y<=MAX_HEIGHT;y++){
+        for(int x=game.map.next_in_row(type,y,1);x>=1 && x<=MAX_WIDTH;x=game.map.next_in_row(type,y,x+1)){
+            DrawCell(x,y);
+        }
     }
 }
 
-void Push_Touch(){
-    wait(0.5);
-    if(game_state==run){
-        MovDir=null;
-        //game_state=pause;
-    }else if(game_state==pause){
-        game_state=run;
-    }else if(game_state == stop){
-        for(int i=0;i<=4;i++){
-            corp[i].x=(head.x)-(i+1);
-            corp[i].y=15;
+// El tablero entero en el buffer
+#if SNAKE_CELL == SNAKE_TILE_SIZE
+void DrawBoard(){
+    if(board_redraw){
+        board_tiles.invalidate();
+        board_redraw = false;
+    }
+    for(int y=0;y<=MAX_HEIGHT+1;y++){
+        for(int x=0;x<=MAX_WIDTH+1;x++){
+            uint8_t tile = game.cell(x,y);
+            if(x == 0 || y == 0 || x == MAX_WIDTH+1 || y == MAX_HEIGHT+1){
+                tile = tile_frame;
+            }else if(x == game.head.x && y == game.head.y){
+                tile = tile_head;
+            }
+            board_tiles.set_tile(x,y,tile);
         }
-        MovDir=null;
-        game_state=run;
     }
+    board_tiles.render();
 }
+#else
+void DrawBoard(){
+    display.load_buffer(board_layer);
+    DrawCell(game.head.x,game.head.y);
+    for(BodyCursor k=game.body.begin();k.index<game.body.size();game.body.next(k)){
+        DrawCell(SnakeGame::Body::cell_x(k.cell),SnakeGame::Body::cell_y(k.cell));
+    }
+    DrawCells(cell_fruit);
+    DrawCells(cell_wall);
+    DrawCells(cell_obstacle);
+}
+#endif
 
 // Move the snake
 void MoveSnake(){
-    if(game_state==run){
-        display.clear_buffer();
-        if(MovDir!=0){
-            for(int i=(score+4);i>=1;i--){
-                corp[i]=corp[i-1];
-            }
-            corp[0]=head;
+    if(game.game_state==run){
+        if(autopilot == pilot_search){
+            game.turn(pilot.next(game));
+        }else if(autopilot == pilot_cycle){
+            game.turn(perfect.next(game));
+        }else if(autopilot == pilot_replay){
+            game.turn(replay.tick());
         }
-        switch(MovDir){
-            case up:
-                head.y-=1;
-                break;
-            case down:
-                head.y+=1;
+        if(autopilot != pilot_replay){
+            recorder.tick(game.dir);
+        }
+        switch(game.step()){
+// Crashed
+            case snake_crashed:
+            case snake_won: // tablero lleno
+                GameOver();
+                if(autopilot != pilot_replay){
+                    recorder.end(game.score);
+                }
+                demo_hold = 20;
                 break;
-            case left:
-                head.x-=1;
+          //Eat the mouse
+            case snake_ate:
+                move.attach(&TickISR, game.period);
                 break;
-            case right:
-                head.x+=1;
+            case snake_moved:
+                DrawBoard();
+                frame_bytes += display.display();
                 break;
-            case null:
+            default:
                 break;
-
-        }
-// Crashed
-        if(head.x==83 ||head.x==0 ||head.y==0 ||head.y==47 ){
-            display.clear_buffer();
-            display.print_string("GameOver",15,5);
-            display.print_string("Perro!",20,15);
-            display.print_string("Your score is :",2,25);
-            char val1 = score/10+48;
-            char val2 = score%10+48;
-            display.print_char(val1,30,35);
-            display.print_char(val2,40,35);
-            display.display();
-            MovDir=null;
-            head.x=15;
-            head.y=15;
-            game_state=stop;
-            //score=0;
-        }else if((head.x==fruit.x)&&(head.y==fruit.y)){
-          //Eat the mouse
-            score+=1;
-            SetFruit();
-            fps=fps-.005;
-            //printf("score: %d",score);
-            return move.attach(&MoveSnake, fps);
-        }else{
-            display.clear_buffer();
-            display.draw_pixel(head.x,head.y,1);
-            //display.display();
-            for(int k=0;k<=(score+4);k++){
-                display.draw_pixel(corp[k].x,corp[k].y,1);
-            }
-            //display.display();
-            display.draw_pixel(fruit.x,fruit.y,1);
-            //display.display();
-            display.draw_rect(0,0, 83, 47);
-            display.display();
-        }
-// Game Over
-        for(int a=0;a<=(score+4);a++){
-            if(corp[a].x==head.x && corp[a].y==head.y){
-                display.clear_buffer();
-                display.print_string("GameOver",15,5);
-                display.print_string("Perro!",20,15);
-                display.print_string("Your score is :",2,25);
-                char val1 = score/10+48;
-                char val2 = score%10+48;
-                display.print_char(val1,30,35);
-                display.print_char(val2,40,35);
-                display.display();
-                MovDir=null;
-                head.x=15;
-                head.y=15;
-                game_state=stop;
-                //score=0;
-                fps=0.1;
-            }
         }
     }
     //Hold the Game
-    else if(game_state==pause){
+    else if(game.game_state==pause){
+        display.composite(board_layer, pause_layer, Nokia5110::pixel_or);
+        board_redraw = true;
+        score_field.invalidate();
+        score_field.set(game.score);
+        frame_bytes += display.display();
+    }
+    // Demo: vuelve a empezar despues de mostrar el GameOver
+    else if(game.game_state==stop && autopilot != pilot_off && --demo_hold <= 0){
+        if(autopilot == pilot_replay){
+            autopilot = DEMO_PILOT;
+        }
+        NewGame();
+    }
+}
+
+// Columna para centrar un texto; se mide sin dibujar
+int16_t Centro(const char *str, const Font &font){
+    return (display.width() - (int16_t) measure_string(str, font)) / 2;
+}
+
+// Rasteriza las pantallas fijas; deja el buffer limpio.
+// La posicion de cada texto se calcula aqui una sola vez.
+void BakeScreens(){
+    // marco de una celda de grueso alrededor del tablero
+    for(int k=0;k<SnakeGame::cell_size;k++){
+        board_list.rect(k,k, SnakeGame::screen_x(MAX_WIDTH+2)-1-k, SnakeGame::screen_y(MAX_HEIGHT+2)-1-k);
+    }
+    board_list.bake(display, board_layer);
+
+    gameover_list.text("GameOver",Centro("GameOver",font_small),5,font_small);
+    gameover_list.text("Perro!",Centro("Perro!",font_small),15,font_small);
+    gameover_list.text("Your score is :",Centro("Your score is :",font_small),25,font_small);
+    gameover_list.bake(display, gameover_layer);
+
+    pause_list.text("Pause",Centro("Pause",font_large),15,font_large);
+    pause_list.bake(display, pause_layer);
+
+    display.clear_buffer();
+}
+
+// Titulo: sube una fila por nota y termina en el menu
+void TitleFrame(int j){
+    if(j == 0){
         display.clear_buffer();
-        display.print_string("Pause",13,15);
+        display.print_string("Move JoyStick",0,20);
         display.display();
+        return;
+    }
+    mySpeaker.StartNote(45*j,0.1,0.1);
+    display.display();
+    display.scroll_vert(-1);
+}
+
+// Cuenta atras antes de la partida
+void SnakeFrame(int j){
+    if(j == 0){
+        return;
+    }
+    display.clear_buffer();
+    display.print_string("I",0,j);
+    display.print_string("Snake game",13,5);
+    mySpeaker.StartNote(100*j,0.1,0.1);
+    mySpeaker.QueueNote(40.0/j,0.1,0.5); // suena al acabar la primera
+    display.display();
+}
+
+// Tick del juego con su registro de telemetria
+void GameTick(){
+    uint32_t tick_start = clock_us.read_us();
+    uint32_t latency = 0;
+    if(input_pending){
+        latency = tick_start - input_us;
+        input_pending = false;
+    }
+    frame_bytes = 0;
+    MoveSnake();
+    telemetry.log_tick(game.score, telemetry_us16((uint32_t) clock_us.read_us() - tick_start),
+                       frame_bytes, telemetry_us16(latency));
+    // el registro de la ultima partida sale poco a poco, sin bloquear
+    if(recorder.finished() && replay_sent < recorder.size()){
+        telemetry.log_replay(recorder.data(), recorder.size(), replay_sent);
     }
 }
 
 
 int main() {
-    joystick.init();
+    clock_us.start();
     display.init(0x2C);
-    display.clear_buffer();
+    uint32_t lcd_us = clock_us.read_us();
+    joystick.init();
+    BakeScreens();
+
+    // el titulo se dibuja una vez y sube desplazando el buffer; el primer
+    // cuadro sale ya y el resto se inicializa mientras suena la musica
+    display.print_string(":V Snake!!",3,10);
+    StartIntro(&TitleFrame, 10, INTRO_STEP);
+    IntroStep();
+    telemetry.log_boot(lcd_us, clock_us.read_us());
+    perfect.init();
     int m=0;
     int p=0;
  
@@ -209,25 +388,26 @@ int main() {
         tab_menu[2]="???";
     */
 
+    // tiempo sin tocar el joystick, uno solo para el menu y la partida: la
+    // demo que arranca desde el menu sigue contando
+    Timer idle;
+    idle.start();
+
     bool isStarted=false;
  
     // Menu
     while(isStarted==false){
-        int j=0;
- 
-        for(j=10;j>0;j--){
-            display.clear_buffer();
-            display.print_string(":V Snake!!",3,j);
-            mySpeaker.PlayNote(45*j,0.1,0.1);
-            //display.print_string("Snake!",13,j);
-            //wait(.2);
-            display.display();
-        }
-        display.clear_buffer();
-        display.print_string("Move JoyStick",0,20);
-        display.display();
- 
+        // sin jugador durante ATTRACT_TIMEOUT segundos: arranca la demo
+        sampler.attach(&SampleISR, JOY_SAMPLE_PERIOD);
         while(1) {
+            WaitEvent();
+            if(intro_due){
+                IntroStep();
+            }
+            if(!sample_due){
+                continue;
+            }
+            sample_due = false;
             //display.print_string(tab_menu[m],0,15);
             //Direction joydir = joystick.get_direction();
             /*int d = joydir;
@@ -249,27 +429,51 @@ int main() {
             }
             else */
             bool button = joystick.get_direction();
+            if(!lcd_on){
+                // con la pantalla apagada el joystick solo la enciende
+                if(button){
+                    PowerUp();
+                    idle.reset();
+                }
+                continue;
+            }
             if(button){
+                StopIntro();
+                idle.reset();
                 p=m;
                 isStarted=true;
                 break;
  
             }
+            if(idle.read() > LCD_IDLE_TIMEOUT){
+                StopIntro();
+                PowerDown();
+                continue;
+            }
+            if(idle.read() > ATTRACT_TIMEOUT){
+                p=m;
+                autopilot=DEMO_PILOT;
+                isStarted=true;
+                break;
+            }
         }
     }
  
     // Snake game_state
     while(isStarted==true && p==0){
-        int j=0;
-        display.clear_buffer();
- 
-        for(j=5;j>0;j--){
-            display.clear_buffer();
-            display.print_string("I",0,j);
-            mySpeaker.PlayNote(100*j,0.1,0.1);
-            display.print_string("Snake game",13,5);
-            mySpeaker.PlayNote(40.0/j,0.1,0.5); 
-            display.display();
+        // cuenta atras sin bloquear; el joystick o el boton la saltan
+        StartIntro(&SnakeFrame, 5, INTRO_SNAKE_STEP);
+        while(intro_left >= 0){
+            if(intro_due){
+                IntroStep();
+            }
+            if(sample_due){
+                sample_due = false;
+                if(joystick.get_direction() != CENTRE || joystick.button_pressed()){
+                    StopIntro();
+                }
+            }
+            WaitEvent();
         }
         /*
         display.locate(0,2);
@@ -281,35 +485,60 @@ int main() {
         }*/
  
         //Snake start
-        game_state=run;
-        display.draw_rect(0,0,83,47);
+        display.load_buffer(board_layer);
         display.display();
-        MovDir=null;
-        MovDir=right;
-        head.x=15;
-        head.y=15;
-        for (int i=0;i<=(score+4);i++){
-            corp[i].x=(head.x)-(i+1);
-            corp[i].y=15;
-        }
-        SetFruit();
-        move.attach(&MoveSnake, fps);
+        NewGame();
         while (1){
-            Direction joydir = joystick.get_direction();
-            //bool button = joystick.get_direction();
-            int d = joydir;
-            if(d == up){
-                up_Dir();}
-            else if(d == down){
-                down_Dir();}
-            else if(d == left){
-                left_Dir();}
-            else if (d == right){
-                right_Dir();}/*
-            else if (button){
-                Push_Touch();}*/
-            printf("score; %d\n",score);
-            wait_ms(10);
+            if(tick_due){
+                tick_due = false;
+                GameTick();
+            }
+            if(sample_due){
+                sample_due = false;
+                Direction joydir = joystick.get_direction();
+                int d = joydir;
+                bool button = joystick.button_pressed();
+                directions last = game.dir;
+                if(d != CENTRE || button){
+                    idle.reset();
+                    if(!lcd_on){
+                        // despierta en una partida nueva
+                        PowerUp();
+                        NewGame();
+                    }
+                }else if(lcd_on && idle.read() > (autopilot == pilot_off ? LCD_IDLE_TIMEOUT : DEMO_IDLE_TIMEOUT)){
+                    // el GameOver se apaga antes; la demo y la repeticion
+                    // siguen un rato mas y luego tambien
+                    PowerDown();
+                }
+                if(autopilot != pilot_off && d != CENTRE){
+                    autopilot=pilot_off; // el jugador toma el control
+                }
+                // GameOver sin jugador: repeticion de la ultima partida
+                if(lcd_on && game.game_state == stop && autopilot == pilot_off &&
+                   idle.read() > ATTRACT_TIMEOUT && recorder.finished() &&
+                   replay.load(recorder.data(), recorder.size())){
+                    autopilot = pilot_replay;
+                    NewGame();
+                }
+                // el boton empieza otra partida despues del GameOver
+                if(button && game.game_state == stop){
+                    NewGame();
+                }
+                if(d == up){
+                    game.turn(up);}
+                else if(d == down){
+                    game.turn(down);}
+                else if(d == left){
+                    game.turn(left);}
+                else if (d == right){
+                    game.turn(right);}
+                if(game.dir != last && !input_pending){
+                    input_us = clock_us.read_us();
+                    input_pending = true;
+                }
+            }
+            WaitEvent();
         }
     }
  
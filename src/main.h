@@ -16,9 +16,10 @@
     #define LEFT 7
     #define CENTER 0*/
 
-    //Constantes de la pantalla
-    #define MAX_WIDTH 82   
-    #define MAX_HEIGHT 46
+    //Tablero: SnakeGame llena la pantalla con celdas de SNAKE_CELL pixeles
+    //(SnakeBody.h); compilar con -DSNAKE_CELL=2 o 4 para celdas mas grandes
+    #define MAX_WIDTH SnakeGame::width
+    #define MAX_HEIGHT SnakeGame::height
 
     //Sonido
     #define SPKR 6
@@ -26,5 +27,38 @@
     //Entorno
     #define FPS 10
 
+    //Segundos sin tocar el joystick en el menu antes de arrancar la demo
+    #define ATTRACT_TIMEOUT 10
+
+    //Segundos sin tocar el joystick antes de apagar la pantalla y parar el juego,
+    //en el menu y el GameOver y con la demo o la repeticion en marcha
+    #define LCD_IDLE_TIMEOUT 60
+    #define DEMO_IDLE_TIMEOUT 300
+
+    //Duracion de cada paso de la presentacion (segundos): titulo y cuenta atras
+    #define INTRO_STEP 0.1f
+    #define INTRO_SNAKE_STEP 0.2f
+
+    //Periodo de lectura del joystick (segundos), normal y con la pantalla apagada
+    #define JOY_SAMPLE_PERIOD 0.01f
+    #define JOY_SLEEP_PERIOD 0.1f
+
+    //Modo de juego: frutas a la vez, muros y obstaculos moviles (1, 0, 0 es el clasico).
+    //La demo con pilot_cycle juega siempre el clasico
+    #define PLAY_FRUITS 1
+    #define PLAY_WALLS 0
+    #define PLAY_OBSTACLES 0
+
+    //Piloto de la demo: pilot_search (camino mas corto) o pilot_cycle (ciclo hamiltoniano, nunca pierde)
+    #define DEMO_PILOT pilot_cycle
+
+
+    //Presupuesto de RAM en bytes: la compilacion falla si un objeto se pasa
+    #define RAM_DISPLAY 1024    // buffer y drivers de la pantalla
+    #define RAM_JOYSTICK 256
+    #define RAM_GAME 11264      // estado del juego con el cuerpo y el mapa
+    #define RAM_PILOTS 17408    // los dos pilotos de la demo
+    #define RAM_SCREENS 4096    // pantallas fijas y campos de texto
+    #define RAM_TOTAL 65536     // todos los objetos globales de main.cpp
 
 #endif /* !MAIN_H_ */
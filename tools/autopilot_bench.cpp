@@ -0,0 +1,110 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Benchmark en el host del piloto automatico
+**
+** Build:  g++ -O2 -I../lib/Snake -I../lib/Autopilot autopilot_bench.cpp \
+**             ../lib/Autopilot/Autopilot.cpp ../lib/Autopilot/Hamiltonian.cpp -o autopilot_bench
+** Usage:  autopilot_bench [games] [budget] [bfs|cycle]
+**
+** Plays whole games with the autopilot and reports how long choosing a move
+** takes. The worst case tick (new search plus a full budget of expansions) is
+** also timed on its own, as the median of many runs; the larger of that and
+** the 99.99th percentile of the game ticks (the maximum is scheduler noise on
+** a desktop OS) is compared against the fastest game tick (SNAKE_MIN_PERIOD).
+** Host times are only indicative; the hard bound on the board is the number
+** of cells expanded per tick, which must never exceed the budget.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include <SnakeGame.h>
+#include <Autopilot.h>
+#include <Hamiltonian.h>
+
+static double now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static SnakeGame game;
+
+int main(int argc, char **argv)
+{
+    int games = argc > 1 ? atoi(argv[1]) : 100;
+    int budget = argc > 2 ? atoi(argv[2]) : AUTOPILOT_BUDGET;
+    bool cycle = argc > 3 && strcmp(argv[3], "cycle") == 0;
+
+    static Autopilot pilot(budget);
+    static HamiltonianPilot perfect;
+    double t_init = now_ns();
+    perfect.init();
+    t_init = now_ns() - t_init;
+    std::vector<double> ticks;
+    unsigned max_expanded = 0;
+    long total_score = 0;
+    int max_score = 0;
+
+    for (int g = 0; g < games; g++) {
+        game.seed(g + 1);
+        game.reset();
+        pilot.reset();
+        // a game the pilot loops in forever is cut after enough ticks
+        for (long t = 0; t < 2000000 && game.game_state == run; t++) {
+            double t0 = now_ns();
+            game.turn(cycle ? perfect.next(game) : pilot.next(game));
+            double t1 = now_ns();
+            game.step();
+
+            ticks.push_back(t1 - t0);
+            max_expanded = std::max<unsigned>(max_expanded, pilot.expanded());
+        }
+        total_score += game.score;
+        max_score = std::max(max_score, game.score);
+    }
+
+    std::sort(ticks.begin(), ticks.end());
+
+    // worst case: the fruit just moved, so the field is rebuilt from scratch
+    std::vector<double> worst_runs;
+    for (int i = 0; i < 1000; i++) {
+        game.reset();
+        pilot.reset();
+        double t0 = now_ns();
+        if (cycle) {
+            perfect.next(game);
+        } else {
+            pilot.next(game);
+        }
+        worst_runs.push_back(now_ns() - t0);
+    }
+    std::sort(worst_runs.begin(), worst_runs.end());
+    double worst = worst_runs[worst_runs.size() / 2];
+    double observed = ticks[ticks.size() - 1 - ticks.size() / 10000];
+    worst = std::max(worst, observed);
+    double tick_ns = SNAKE_MIN_PERIOD * 1e9;
+
+    printf("pilot            %s\n", cycle ? "hamiltonian cycle" : "bfs");
+    if (cycle) {
+        printf("cycle init       %.0f ns, %zu bytes\n", t_init, sizeof(perfect));
+    }
+    printf("games            %d\n", games);
+    printf("ticks            %zu\n", ticks.size());
+    printf("score            avg %.1f max %d\n", (double) total_score / games, max_score);
+    printf("budget           %d cells/tick, max used %u\n", budget, max_expanded);
+    printf("pilot time       p50 %.0f ns  p99 %.0f ns  p99.99 %.0f ns\n",
+           ticks[ticks.size() / 2], ticks[ticks.size() * 99 / 100], observed);
+    printf("worst case tick  %.0f ns\n", worst);
+    printf("fastest tick     %.0f ns (%.3f%% used in the worst case)\n", tick_ns, 100.0 * worst / tick_ns);
+
+    bool ok = max_expanded <= (unsigned) budget && worst < tick_ns;
+    printf("%s\n", ok ? "OK: never overruns the tick" : "FAIL: tick overrun");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Convierte imagenes al formato nativo de la pantalla (bancos de 8 pixeles en columna)
+**
+** Build:  g++ -O2 bmpconv.cpp -o bmpconv
+** Usage:  bmpconv [-n name] [-r WxH] [-rle] image > image.h
+**
+** Input is a WBMP (type 0) or binary PBM (P4) file, or with -r the unpadded
+** row-major MSB-first data taken by Raster::draw_bitmap(). Output is a C
+** header with the bitmap in the layout taken by Raster::blit_bitmap():
+** ceil(H / 8) rows of W bytes, one byte per 8 pixel column, LSB on top.
+** With -rle the same byte stream is run-length packed for
+** Raster::blit_rle() (see LCD_RLE_RUN in Raster.h).
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static std::vector<uint8_t> data;
+static size_t pos;
+
+static bool read_file(const char *path)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return false;
+    }
+    int c;
+    while ((c = fgetc(in)) != EOF) {
+        data.push_back(c);
+    }
+    fclose(in);
+    return true;
+}
+
+static unsigned wbmp_int()
+{
+    unsigned v = 0;
+    while (pos < data.size()) {
+        uint8_t b = data[pos++];
+        v = (v << 7) | (b & 0x7F);
+        if (!(b & 0x80)) {
+            break;
+        }
+    }
+    return v;
+}
+
+static unsigned pbm_int()
+{
+    while (pos < data.size()) {
+        if (data[pos] == '#') {
+            while (pos < data.size() && data[pos] != '\n') {
+                pos++;
+            }
+        } else if (isspace(data[pos])) {
+            pos++;
+        } else {
+            break;
+        }
+    }
+    unsigned v = 0;
+    while (pos < data.size() && isdigit(data[pos])) {
+        v = v * 10 + (data[pos++] - '0');
+    }
+    return v;
+}
+
+// LCD_RLE_RUN blocks: runs of 2..129 equal bytes, literals of 1..128 bytes
+static std::vector<uint8_t> rle_pack(const std::vector<uint8_t> &in)
+{
+    std::vector<uint8_t> out;
+    size_t i = 0;
+    while (i < in.size()) {
+        size_t run = 1;
+        while (i + run < in.size() && run < 129 && in[i + run] == in[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            out.push_back(0x80 | (run - 2));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+        // literal up to the next run of 3, a run of 2 is not worth a new block
+        size_t start = i++;
+        while (i < in.size() && i - start < 128 &&
+               !(i + 2 < in.size() && in[i] == in[i + 1] && in[i] == in[i + 2])) {
+            i++;
+        }
+        out.push_back(i - start - 1);
+        out.insert(out.end(), in.begin() + start, in.begin() + i);
+    }
+    return out;
+}
+
+static std::vector<uint8_t> rle_unpack(const std::vector<uint8_t> &in, size_t size)
+{
+    std::vector<uint8_t> out;
+    size_t i = 0;
+    while (i < in.size() && out.size() < size) {
+        uint8_t code = in[i++];
+        if (code & 0x80) {
+            out.insert(out.end(), (code & 0x7F) + 2, in[i++]);
+        } else {
+            out.insert(out.end(), in.begin() + i, in.begin() + i + code + 1);
+            i += code + 1;
+        }
+    }
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = "bitmap";
+    const char *path = NULL;
+    unsigned width = 0, height = 0;
+    bool raw = false;
+    bool rle = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            name = argv[++i];
+        } else if (!strcmp(argv[i], "-rle")) {
+            rle = true;
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            raw = sscanf(argv[++i], "%ux%u", &width, &height) == 2;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path || !read_file(path)) {
+        fprintf(stderr, "usage: %s [-n name] [-r WxH] [-rle] image.wbmp|image.pbm|raw.bin\n", argv[0]);
+        return 1;
+    }
+
+    // row stride in bits, rows are padded to a byte in WBMP and PBM only
+    unsigned stride;
+    if (raw) {
+        stride = width;
+    } else if (data.size() > 2 && data[0] == 'P' && data[1] == '4') {
+        pos = 2;
+        width = pbm_int();
+        height = pbm_int();
+        pos++; // single whitespace before the raster
+        stride = (width + 7) / 8 * 8;
+    } else if (data.size() > 2 && data[0] == 0 && data[1] == 0) {
+        pos = 2;
+        width = wbmp_int();
+        height = wbmp_int();
+        stride = (width + 7) / 8 * 8;
+    } else {
+        fprintf(stderr, "%s: not a WBMP or P4 PBM file, use -r WxH for raw data\n", path);
+        return 1;
+    }
+    if (!width || !height || width > 255 || height > 255 ||
+        pos + (stride * height + 7) / 8 > data.size()) {
+        fprintf(stderr, "%s: bad or truncated image\n", path);
+        return 1;
+    }
+
+    unsigned rows = (height + 7) / 8;
+    std::vector<uint8_t> out(rows * width, 0);
+    for (unsigned y = 0; y < height; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            unsigned bit = y * stride + x;
+            if (data[pos + bit / 8] & (0x80 >> (bit % 8))) {
+                out[(y / 8) * width + x] |= 1 << (y % 8);
+            }
+        }
+    }
+
+    if (rle) {
+        std::vector<uint8_t> packed = rle_pack(out);
+        if (rle_unpack(packed, out.size()) != out) {
+            fprintf(stderr, "%s: rle round trip failed\n", path);
+            return 1;
+        }
+        fprintf(stderr, "%s: %zu bytes packed to %zu\n", path, out.size(), packed.size());
+        out.swap(packed);
+        printf("// %s: %ux%u, run-length packed for Raster::blit_rle()\n", name, width, height);
+    } else {
+        printf("// %s: %ux%u, native layout for Raster::blit_bitmap()\n", name, width, height);
+    }
+    printf("// generated by tools/bmpconv.cpp from %s\n", path);
+    printf("const uint8_t %s_width = %u;\n", name, width);
+    printf("const uint8_t %s_height = %u;\n", name, height);
+    printf("const uint8_t %s[%zu] = {", name, out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        printf("%s0x%02X%s", i % 12 ? " " : "\n    ", out[i], i + 1 < out.size() ? "," : "");
+    }
+    printf("\n};\n");
+    return 0;
+}
@@ -0,0 +1,300 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Barrido exhaustivo de circulos, elipses y rectangulos redondeados de Raster
+** contra una referencia de 64 bits
+**
+** Build:  g++ -O2 -I../lib/Nokia5110 ellipse_sweep.cpp ../lib/Nokia5110/Raster.cpp \
+**             ../lib/Nokia5110/Font.cpp -o ellipse_sweep
+** Usage:  ellipse_sweep [max_radius]   (ellipse radii, 255 by default: every uint8_t radius)
+**
+** For every a and b from 0 to max_radius, draw_ellipse and fill_ellipse (and
+** draw_circle and fill_circle when a == b) are drawn in pixel_xor on a
+** cleared 128x64 screen and compared byte for byte with the reference. The
+** center is placed so that each quarter in turn lies on the screen, moved by
+** one screen at a time when the shape is larger, so every pixel of every
+** shape is checked, along with everything around it staying clear. A pixel
+** drawn twice cancels itself in pixel_xor and shows up as a mismatch.
+**
+** Then every draw_rrect and fill_rrect that fits the screen is checked the
+** same way: every width and height, every radius up to half the shorter
+** side, plus radius 255 to check that it is cut down to that half, with the
+** corners given in both orders.
+**
+** The reference follows the definition, with 64-bit integers and no error
+** terms: column dx of a quarter holds the row
+**
+**   h(dx) = largest h <= b with a^2 (2h - 1)^2 < 4 b^2 (a^2 - dx^2), else 0
+**
+** (the last row whose top edge is inside the ideal ellipse), and row dy
+** holds the column
+**
+**   w(dy) = smallest w <= a with b^2 (2w + 1)^2 >= 4 a^2 (b^2 - dy^2), else a
+**
+** The outline is the union of both and the fill is every row up to the
+** outline in each column; a flat ellipse (a or b 0) is a filled line. A
+** rounded rectangle puts the four quarters of a circle of radius r in its
+** corners, with only the top and bottom rows (or everything, when filled)
+** in the columns between them. The outline of a column must also be a
+** single run that touches the next column's, i.e. the outline has no gaps.
+**
+** The first mismatch prints the call and the pixel and stops.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Raster.h>
+
+#define W RASTER_MAX_WIDTH
+#define H RASTER_MAX_HEIGHT
+
+typedef long long int64;
+
+// outline rows of each column of the quarter, dx >= 0 and dy >= 0
+static int lo[256], hi[256];
+
+static uint8_t expected[W * H / 8];
+
+// builds lo and hi for radii a, b; false if a column is not a single run
+// or does not touch the next one
+static bool reference(int a, int b)
+{
+    int run0[256], run1[256];
+    for (int dx = 0; dx <= a; dx++) {
+        run0[dx] = 0x7FFF;
+        run1[dx] = -1;
+    }
+
+    // h() only goes down as dx grows and w() only goes up as dy drops
+    int h = b;
+    for (int dx = 0; dx <= a; dx++) {
+        while (h > 0 && !((int64) a * a * (2 * h - 1) * (2 * h - 1) <
+                          4LL * b * b * ((int64) a * a - (int64) dx * dx))) {
+            h--;
+        }
+        lo[dx] = h;
+        hi[dx] = h;
+    }
+    int w = 0;
+    for (int dy = b; dy >= 0; dy--) {
+        while (w < a && (int64) b * b * (2 * w + 1) * (2 * w + 1) <
+                        4LL * a * a * ((int64) b * b - (int64) dy * dy)) {
+            w++;
+        }
+        if (dy < run0[w]) {
+            run0[w] = dy;
+        }
+        if (dy > run1[w]) {
+            run1[w] = dy;
+        }
+    }
+
+    for (int dx = 0; dx <= a; dx++) {
+        if (run1[dx] < 0) {
+            continue;
+        }
+        if (lo[dx] < run0[dx] - 1 || lo[dx] > run1[dx] + 1) {
+            return false;
+        }
+        if (run0[dx] < lo[dx]) {
+            lo[dx] = run0[dx];
+        }
+        if (run1[dx] > hi[dx]) {
+            hi[dx] = run1[dx];
+        }
+    }
+    for (int dx = 0; dx < a; dx++) {
+        if (lo[dx] > hi[dx + 1] + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void expect_span(int x, int y0, int y1)
+{
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (y1 > H - 1) {
+        y1 = H - 1;
+    }
+    for (int y = y0; y <= y1; y++) {
+        expected[x + (y / 8) * W] |= 1 << (y % 8);
+    }
+}
+
+// the shape with quarter centers cx0, cy0 - cx1, cy1 as the reference draws
+// it: an ellipse has a single center, a rounded rectangle has its straight
+// edges between the centers (hi[0] is the vertical radius)
+static void expect(int cx0, int cy0, int cx1, int cy1, int a, bool fill)
+{
+    memset(expected, 0, sizeof(expected));
+    for (int x = 0; x < W; x++) {
+        if (x > cx0 && x < cx1) {
+            if (fill) {
+                expect_span(x, cy0 - hi[0], cy1 + hi[0]);
+            } else {
+                expect_span(x, cy0 - hi[0], cy0 - hi[0]);
+                expect_span(x, cy1 + hi[0], cy1 + hi[0]);
+            }
+            continue;
+        }
+        int dx = x <= cx0 ? cx0 - x : x - cx1;
+        if (dx > a) {
+            continue;
+        }
+        if (fill || lo[dx] == 0) {
+            expect_span(x, cy0 - hi[dx], cy1 + hi[dx]);
+        } else {
+            expect_span(x, cy0 - hi[dx], cy0 - lo[dx]);
+            expect_span(x, cy1 + lo[dx], cy1 + hi[dx]);
+        }
+    }
+}
+
+// compares the buffer with the reference, printing the first wrong pixel
+static bool matches(const Raster &lcd, const char *call)
+{
+    const uint8_t *buffer = lcd.buffer();
+    if (!memcmp(buffer, expected, sizeof(expected))) {
+        return true;
+    }
+    for (int i = 0; i < (int) sizeof(expected); i++) {
+        uint8_t diff = buffer[i] ^ expected[i];
+        if (diff) {
+            int y = (i / W) * 8 + __builtin_ctz(diff);
+            fprintf(stderr, "ellipse_sweep: %s on %dx%d\n  pixel %d,%d is %d, the reference has %d\n",
+                    call, W, H, i % W, y, (buffer[i] >> (y % 8)) & 1, (expected[i] >> (y % 8)) & 1);
+            break;
+        }
+    }
+    return false;
+}
+
+enum Call { call_draw_ellipse, call_fill_ellipse, call_draw_circle, call_fill_circle };
+
+static const char *call_names[4] = {"draw_ellipse", "fill_ellipse", "draw_circle", "fill_circle"};
+
+// every ellipse and circle with radii up to max_radius
+static bool sweep_ellipses(Raster &lcd, int max_radius, long &shapes)
+{
+    char call[96];
+    for (int a = 0; a <= max_radius; a++) {
+        for (int b = 0; b <= max_radius; b++) {
+            if (!reference(a, b)) {
+                fprintf(stderr, "ellipse_sweep: outline of a=%d b=%d has a gap\n", a, b);
+                return false;
+            }
+            for (int kind = 0; kind < (a == b ? 4 : 2); kind++) {
+                bool fill = kind == call_fill_ellipse || kind == call_fill_circle || !a || !b;
+
+                // the quarter toward +x, +y from a center at the top left
+                // corner, then the others from the other corners, one screen
+                // further each time until the whole quarter was seen
+                for (int quarter = 0; quarter < 4; quarter++) {
+                    for (int tx = 0; tx * W <= a; tx++) {
+                        for (int ty = 0; ty * H <= b; ty++) {
+                            int cx = (quarter & 1) ? W - 1 + tx * W : -tx * W;
+                            int cy = (quarter & 2) ? H - 1 + ty * H : -ty * H;
+
+                            lcd.clear_buffer();
+                            switch (kind) {
+                            case call_draw_ellipse:
+                                lcd.draw_ellipse(cx, cy, a, b, Raster::pattern_black, Raster::pixel_xor);
+                                break;
+                            case call_fill_ellipse:
+                                lcd.fill_ellipse(cx, cy, a, b, Raster::pattern_black, Raster::pixel_xor);
+                                break;
+                            case call_draw_circle:
+                                lcd.draw_circle(cx, cy, a, Raster::pattern_black, Raster::pixel_xor);
+                                break;
+                            default:
+                                lcd.fill_circle(cx, cy, a, Raster::pattern_black, Raster::pixel_xor);
+                                break;
+                            }
+                            expect(cx, cy, cx, cy, a, fill);
+                            snprintf(call, sizeof(call), "%s(%d, %d, a=%d, b=%d)", call_names[kind], cx, cy, a, b);
+                            if (!matches(lcd, call)) {
+                                return false;
+                            }
+                        }
+                    }
+                }
+                shapes++;
+            }
+        }
+    }
+    return true;
+}
+
+// every rounded rectangle that fits the screen, with every radius up to half
+// its shorter side and one larger radius that gets cut to that, given with
+// the corners in both orders
+static bool sweep_rrects(Raster &lcd, long &shapes)
+{
+    char call[96];
+    for (int r = 0; r <= (H - 1) / 2; r++) {
+        if (!reference(r, r)) {
+            fprintf(stderr, "ellipse_sweep: outline of r=%d has a gap\n", r);
+            return false;
+        }
+        for (int w = 2 * r; w < W; w++) {
+            for (int h = 2 * r; h < H; h++) {
+                int limit = (w < h ? w : h) / 2;
+                for (int asked = r; asked <= 255; asked = (asked == r && limit == r) ? 255 : 256) {
+                    for (int kind = 0; kind < 4; kind++) {
+                        bool fill = kind & 1;
+                        int x0 = 0, y0 = 0, x1 = w, y1 = h;
+                        if (kind & 2) {
+                            x0 = w;
+                            y0 = h;
+                            x1 = 0;
+                            y1 = 0;
+                        }
+
+                        lcd.clear_buffer();
+                        if (fill) {
+                            lcd.fill_rrect(x0, y0, x1, y1, asked, Raster::pattern_black, Raster::pixel_xor);
+                        } else {
+                            lcd.draw_rrect(x0, y0, x1, y1, asked, Raster::pattern_black, Raster::pixel_xor);
+                        }
+                        expect(r, r, w - r, h - r, r, fill);
+                        snprintf(call, sizeof(call), "%s(%d, %d, %d, %d, r=%d)",
+                                 fill ? "fill_rrect" : "draw_rrect", x0, y0, x1, y1, asked);
+                        if (!matches(lcd, call)) {
+                            return false;
+                        }
+                        shapes++;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int max_radius = argc > 1 ? atoi(argv[1]) : 255;
+    if (max_radius < 0 || max_radius > 255) {
+        fprintf(stderr, "usage: %s [max_radius]   (0-255)\n", argv[0]);
+        return 1;
+    }
+
+    // exact size, like the firmware's buffer
+    uint32_t *words = (uint32_t *) malloc(W * H / 8);
+    Raster lcd(words, W, H);
+
+    long ellipses = 0, rrects = 0;
+    if (!sweep_ellipses(lcd, max_radius, ellipses) || !sweep_rrects(lcd, rrects)) {
+        return 1;
+    }
+    printf("%ld ellipses and circles up to radius %d, %ld rounded rectangles, outline and fill, no mismatch\n",
+           ellipses, max_radius, rrects);
+    free(words);
+    return 0;
+}
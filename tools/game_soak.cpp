@@ -0,0 +1,430 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Prueba de resistencia de las reglas del juego con tiempo acelerado
+**
+** Build:  g++ -O2 -std=c++11 -pthread -I../lib/Snake -I../lib/Autopilot game_soak.cpp \
+**             ../lib/Autopilot/Hamiltonian.cpp -o game_soak
+** Checks: g++ -O1 -g -std=c++11 -pthread -fsanitize=address,undefined -fno-sanitize-recover=all \
+**             -I../lib/Snake -I../lib/Autopilot game_soak.cpp ../lib/Autopilot/Hamiltonian.cpp -o game_soak
+** Usage:  game_soak [-n ticks] [-t threads] [-s seed] [-c check_every] [-m fruits,walls,obstacles]
+**
+** Plays games with the rules from lib/Snake as fast as the host allows until
+** `ticks` ticks have been played, on every core, and reports ticks per
+** second and the game time they stand for. -n sets the tick count, 1e9 by
+** default; it accepts scientific notation such as 2.5e8. Game j is seeded
+** with seed + j and played by one of:
+**
+**  - random: turns at random, often twice within a tick, stops (dir = null,
+**    as before the first turn of a game) and now and then starts over in the
+**    middle of a game
+**  - greedy: moves to a free neighbour, toward the fruit when it can; games
+**    are long and the small board gets filled
+**  - cycle:  HamiltonianPilot, which never dies and fills the whole board
+**
+** on the default board (even seeds) or on a small 8x6 board (odd seeds),
+** where greedy stands in for cycle. Half the games are classic, the others
+** get random fruits, walls and obstacles (or the GameMode given with -m).
+** After every tick the cheap rules are checked (head on the board and off
+** the body, walls and obstacles, `fruit` on a fruit cell, length and score,
+** period within the speed curve, walls and obstacles all still there, no
+** crash into the neck); every `check_every` ticks (4096 by default) the
+** whole board is checked as well (every tick on the small board): each body
+** segment next to the previous one and marked in the occupancy bitmap and
+** nothing else marked, the cell index against a scan of every cell, and
+** `fruit` the nearest fruit to the head.
+** The first broken rule prints the game seed, the player and the tick, and
+** stops with exit code 1; `game_soak -s <seed> -t 1 -n 1` plays that game
+** again on its own.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <SnakeGame.h>
+#include <Hamiltonian.h>
+
+#define CHUNK 4
+#define MAX_GAME_TICKS 20000000L // a game still running is cut here
+
+typedef BasicSnakeGame<8, 6> SmallGame;
+
+enum Player { player_random, player_greedy, player_cycle, players };
+
+static const char *player_names[players] = {"random", "greedy", "cycle"};
+static const directions all_dirs[4] = {up, right, down, left};
+
+struct Totals {
+    long ticks;
+    long games;
+    long won;
+    long crashed;
+    long cut;
+    int best;
+    double seconds; // game time
+};
+
+static HamiltonianPilot cycle_pilot; // read only once built, shared
+
+static std::atomic<bool> failed(false);
+
+// xorshift32, separate from the game's so the players don't shift the fruit
+static uint32_t next_random(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void step_to(int &x, int &y, directions d)
+{
+    x += (d == right) - (d == left);
+    y += (d == down) - (d == up);
+}
+
+template <class Game>
+static directions greedy(const Game &game, uint32_t &rng)
+{
+    directions best = game.dir;
+    int best_dist = 1 << 30;
+    int first = next_random(rng) % 4; // breaks ties at random
+    for (int i = 0; i < 4; i++) {
+        directions d = all_dirs[(first + i) % 4];
+        int x = game.head.x, y = game.head.y;
+        step_to(x, y, d);
+        if (game.occupied(x, y)) {
+            continue;
+        }
+        int dist = abs(x - game.fruit.x) + abs(y - game.fruit.y);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = d;
+        }
+    }
+    return best;
+}
+
+// only the default board has a Hamiltonian cycle built
+static directions cycle(const SnakeGame &game, uint32_t &) { return cycle_pilot.next(game); }
+static directions cycle(const SmallGame &game, uint32_t &rng) { return greedy(game, rng); }
+
+template <class Game>
+static bool fail(const Game &game, uint32_t seed, Player player, long tick, const char *what)
+{
+    if (!failed.exchange(true)) {
+        fprintf(stderr, "%dx%d board, seed %u, %s player, tick %ld: %s\n"
+                        "  head %d,%d  fruit %d,%d  score %d  length %d  dir %d\n",
+                Game::width, Game::height, (unsigned) seed, player_names[player], tick, what,
+                game.head.x, game.head.y, game.fruit.x, game.fruit.y, game.score, game.body.size(), game.dir);
+    }
+    return false;
+}
+
+static bool next_to(int x0, int y0, int x1, int y1)
+{
+    return abs(x0 - x1) + abs(y0 - y1) == 1;
+}
+
+// walks the whole body against the occupancy bitmap
+template <class Game>
+static const char *check_body(const Game &game)
+{
+    typedef typename Game::Body Body;
+    int x = game.head.x, y = game.head.y;
+    for (BodyCursor k = game.body.begin(); k.index < game.body.size(); game.body.next(k)) {
+        int sx = Body::cell_x(k.cell), sy = Body::cell_y(k.cell);
+        if (!next_to(x, y, sx, sy)) {
+            return "body segment not next to the previous one";
+        }
+        if (sx < 1 || sx > Game::width || sy < 1 || sy > Game::height || !game.occupied(sx, sy)) {
+            return "body segment missing from the occupancy bitmap";
+        }
+        x = sx;
+        y = sy;
+    }
+
+    int marked = 0;
+    for (int cy = 1; cy <= Game::height; cy++) {
+        for (int cx = 1; cx <= Game::width; cx++) {
+            marked += game.cell(cx, cy) == cell_snake && (cx != game.head.x || cy != game.head.y);
+        }
+    }
+    if (marked != game.body.size()) {
+        return "occupancy bitmap holds cells off the body";
+    }
+
+    // the index against the plane, and the nearest fruit by brute force
+    int nearest = 1 << 30;
+    for (uint8_t type = cell_fruit; type <= cell_obstacle; type++) {
+        int found = 0;
+        for (int cy = 0; cy <= Game::height + 1; cy++) {
+            int next = game.map.next_in_row(type, cy, 0);
+            for (int cx = 0; cx <= Game::width + 1; cx++) {
+                if (game.map.get(cx, cy) != type) {
+                    continue;
+                }
+                if (next != cx) {
+                    return "row bitset out of step with the plane";
+                }
+                next = game.map.next_in_row(type, cy, cx + 1);
+                found++;
+                if (type == cell_fruit) {
+                    nearest = std::min(nearest, abs(cx - game.head.x) + abs(cy - game.head.y));
+                }
+            }
+            if (next != -1) {
+                return "row bitset holds a cell the plane doesn't";
+            }
+        }
+        if (found != game.map.count(type)) {
+            return "cell count out of step with the plane";
+        }
+    }
+    if (abs(game.fruit.x - game.head.x) + abs(game.fruit.y - game.head.y) != nearest) {
+        return "fruit is not the nearest one";
+    }
+    return NULL;
+}
+
+// the rules that must hold after every tick
+template <class Game>
+static const char *check_tick(const Game &game, SnakeEvent ev, int score, const SpeedCurve &curve,
+                              const GameMode &placed)
+{
+    if (ev == snake_crashed) {
+        // the old head is segment 0 now, the neck it had is segment 1
+        objeto neck = game.segment(1);
+        if (game.head.x == neck.x && game.head.y == neck.y) {
+            return "turned back into the neck";
+        }
+        return game.game_state == stop ? NULL : "still running after a crash";
+    }
+    if (game.map.count(cell_wall) != placed.walls || game.map.count(cell_obstacle) != placed.obstacles) {
+        return "a wall or an obstacle was lost";
+    }
+    if (ev == snake_won) {
+        if (game.map.count(cell_fruit) || game.body.size() + 1 + placed.walls + placed.obstacles != Game::cells) {
+            return "won with free cells left";
+        }
+        return game.game_state == stop ? NULL : "still running after filling the board";
+    }
+    if (game.score != score + (ev == snake_ate)) {
+        return "score out of step with the fruit eaten";
+    }
+    if (game.body.size() != game.length()) {
+        return "body size differs from the length";
+    }
+    if (game.period > curve.start || game.period < curve.min) {
+        return "period outside the speed curve";
+    }
+    if (game.game_state != run) {
+        return NULL;
+    }
+    if (game.head.x < 1 || game.head.x > Game::width || game.head.y < 1 || game.head.y > Game::height) {
+        return "head off the board";
+    }
+    if (game.occupied(game.head.x, game.head.y)) {
+        return "head on the body";
+    }
+    if (game.fruit.x < 1 || game.fruit.x > Game::width || game.fruit.y < 1 || game.fruit.y > Game::height) {
+        return "fruit off the board";
+    }
+    if (game.occupied(game.fruit.x, game.fruit.y) || (game.fruit.x == game.head.x && game.fruit.y == game.head.y)) {
+        return "fruit on the snake";
+    }
+    if (game.cell(game.fruit.x, game.fruit.y) != cell_fruit) {
+        return "fruit points at a cell without one";
+    }
+    return NULL;
+}
+
+template <class Game>
+static bool play(Game &game, uint32_t seed, long check_every, const GameMode *force, Totals &tot)
+{
+    uint32_t rng = seed * 2654435761u + 1;
+    Player player = (Player) (next_random(rng) % players);
+
+    GameMode mode = SnakeGame::classic_mode;
+    if (force) {
+        mode = *force;
+    } else if (next_random(rng) % 2) {
+        // about one cell in 16 taken by fruits, walls and obstacles
+        int room = Game::cells / 16 + 1;
+        mode.fruits = 1 + next_random(rng) % room;
+        mode.walls = next_random(rng) % room;
+        mode.obstacles = next_random(rng) % (SNAKE_MAX_OBSTACLES + 1);
+    }
+    game.set_mode(mode);
+
+    // a fast curve most of the time, the default one otherwise
+    SpeedCurve curve = SnakeGame::default_speed;
+    if (next_random(rng) % 4) {
+        curve.step = 0.001f * (1 + next_random(rng) % 50);
+    }
+    game.set_speed(curve);
+    game.seed(seed);
+    game.reset();
+    GameMode placed = {0, (uint8_t) game.map.count(cell_wall), (uint8_t) game.map.count(cell_obstacle)};
+
+    const char *broken = check_body(game);
+    if (broken) {
+        return fail(game, seed, player, 0, broken);
+    }
+
+    long t = 0;
+    SnakeEvent ev = snake_moved;
+    while (t < MAX_GAME_TICKS && game.game_state != stop) {
+        uint32_t r = next_random(rng);
+        switch (player) {
+        case player_random:
+            if (game.dir == null || (r & 0xFF) == 0) {
+                game.dir = null; // stopped, as before the first turn
+                if ((r >> 8) & 1) {
+                    game.turn(all_dirs[(r >> 9) % 4]);
+                }
+            } else if ((r & 3) == 0) {
+                game.turn(all_dirs[(r >> 9) % 4]);
+                if ((r >> 11) & 1) {
+                    game.turn(all_dirs[(r >> 12) % 4]); // second turn in the same tick
+                }
+            }
+            if ((r >> 20) == 0) {
+                game.reset(); // about once every 4096 ticks
+                placed.walls = game.map.count(cell_wall);
+                placed.obstacles = game.map.count(cell_obstacle);
+            }
+            break;
+        case player_greedy:
+            game.turn(greedy(game, rng));
+            break;
+        default:
+            game.turn(cycle(game, rng));
+            break;
+        }
+
+        int score = game.score;
+        ev = game.step();
+        t++;
+        if (ev != snake_idle) {
+            tot.seconds += game.period;
+        }
+
+        broken = check_tick(game, ev, score, curve, placed);
+        if (!broken && game.game_state == run && (t % check_every == 0 || Game::cells < 256)) {
+            broken = check_body(game);
+        }
+        if (broken) {
+            return fail(game, seed, player, t, broken);
+        }
+    }
+
+    tot.ticks += t;
+    tot.games++;
+    tot.won += ev == snake_won;
+    tot.crashed += ev == snake_crashed;
+    tot.cut += game.game_state != stop;
+    tot.best = std::max(tot.best, game.score);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    long target = 1000000000L;
+    int threads = std::thread::hardware_concurrency();
+    uint32_t seed = 1;
+    long check_every = 4096;
+    GameMode force;
+    bool forced = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            target = (long) strtod(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            check_every = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            unsigned int f, w, o;
+            if (sscanf(argv[++i], "%u,%u,%u", &f, &w, &o) != 3 || f < 1 || f > 255 || w > 255 || o > 255) {
+                fprintf(stderr, "bad mode %s, expected fruits,walls,obstacles\n", argv[i]);
+                return 1;
+            }
+            force.fruits = f;
+            force.walls = w;
+            force.obstacles = o;
+            forced = true;
+        } else {
+            fprintf(stderr, "usage: %s [-n ticks] [-t threads] [-s seed] [-c check_every] [-m fruits,walls,obstacles]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    threads = std::max(threads, 1);
+    check_every = std::max(check_every, 1L);
+    cycle_pilot.init();
+
+    // games are handed out in small chunks until enough ticks are played
+    std::atomic<long> next_game(0);
+    std::atomic<long> played(0);
+    std::vector<Totals> totals(threads);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.push_back(std::thread([&, t]() {
+            SnakeGame *big = new SnakeGame(); // too big for a thread stack
+            SmallGame small;
+            Totals &tot = totals[t];
+            memset(&tot, 0, sizeof(tot));
+            while (!failed && played < target) {
+                long begin = next_game.fetch_add(CHUNK);
+                for (long j = begin; j < begin + CHUNK && !failed; j++) {
+                    long before = tot.ticks;
+                    uint32_t game_seed = seed + (uint32_t) j;
+                    if (game_seed % 2 == 0) {
+                        play(*big, game_seed, check_every, forced ? &force : NULL, tot);
+                    } else {
+                        play(small, game_seed, check_every, forced ? &force : NULL, tot);
+                    }
+                    played += tot.ticks - before;
+                }
+            }
+            delete big;
+        }));
+    }
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (failed) {
+        return 1;
+    }
+
+    Totals all;
+    memset(&all, 0, sizeof(all));
+    for (size_t t = 0; t < totals.size(); t++) {
+        all.ticks += totals[t].ticks;
+        all.games += totals[t].games;
+        all.won += totals[t].won;
+        all.crashed += totals[t].crashed;
+        all.cut += totals[t].cut;
+        all.best = std::max(all.best, totals[t].best);
+        all.seconds += totals[t].seconds;
+    }
+
+    printf("%ld ticks in %ld games on %d threads, %.2f s\n", all.ticks, all.games, threads, wall);
+    printf("  %.1fM ticks/s, %.1f days of game time\n", all.ticks / wall / 1e6, all.seconds / 86400);
+    printf("  %ld crashed, %ld filled the board, %ld cut at %ld ticks, best score %d\n",
+           all.crashed, all.won, all.cut, MAX_GAME_TICKS, all.best);
+    printf("no rule broken\n");
+    return 0;
+}
@@ -0,0 +1,25 @@
+#
+# EPITECH PROJECT, 2018
+# Alberto Esquer
+# File description:
+# Objetivo "ram" de PlatformIO: tamano de las secciones y simbolos que mas RAM ocupan
+#
+# Usage:  pio run -t ram
+#
+# Static objects live in .data and .bss; with no heap use in the firmware the
+# listing below is the whole RAM budget apart from the stacks.
+
+Import("env")
+
+elf = "$BUILD_DIR/${PROGNAME}.elf"
+
+env.AddCustomTarget(
+    name="ram",
+    dependencies=elf,
+    actions=[
+        "$SIZETOOL -A %s" % elf,
+        "arm-none-eabi-nm -C -S --size-sort --reverse-sort %s | grep -i ' [bd] ' | head -n 25" % elf,
+    ],
+    title="RAM report",
+    description="Section sizes and the 25 largest objects in RAM",
+)
@@ -0,0 +1,761 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Prueba aleatoria de Raster contra un rasterizador de referencia, pixel a pixel
+**
+** Build:  g++ -O1 -g -fsanitize=address,undefined -fno-sanitize-recover=all \
+**             -I../lib/Nokia5110 raster_fuzz.cpp ../lib/Nokia5110/Raster.cpp \
+**             ../lib/Nokia5110/Font.cpp -o raster_fuzz
+** Usage:  raster_fuzz [cases] [seed]
+**
+** libFuzzer:  clang++ -O1 -g -fsanitize=fuzzer,address,undefined -DRASTER_FUZZ_LIBFUZZER \
+**                 -I../lib/Nokia5110 raster_fuzz.cpp ../lib/Nokia5110/Raster.cpp \
+**                 ../lib/Nokia5110/Font.cpp -o raster_fuzz && ./raster_fuzz
+**
+** Every case is a byte string decoded into a screen size (84x48 or 128x64)
+** and a list of draw calls with coordinates from on screen to the whole
+** int16_t range, random modes, patterns, clip rectangles and bitmaps. After
+** each call the buffer is checked against a reference that draws one pixel
+** at a time:
+**
+**  - pixels, lines along the axes, rectangles, bitmaps (all three formats),
+**    text, copy, scroll, fill, invert, composite and draw_byte must match
+**    the reference exactly
+**  - lines must match the whole Bresenham line cut to the clip rectangle
+**  - circles, ellipses and rounded rectangles are checked by property: the
+**    pixels covered lie inside the clip rectangle and between the inner and
+**    outer ideal shapes, and outlines are part of the filled shape
+**  - drawing a line or a shape in any mode equals applying that mode once to
+**    every covered pixel (nothing is drawn twice)
+**  - the dirty box covers every byte that changed
+**
+** The buffer is allocated at its exact size, so with AddressSanitizer any
+** write outside it stops the run. The first mismatch prints the call and
+** the pixel and aborts. Without libFuzzer the cases come from a seeded
+** generator, so a failure is reproduced by running again with the same seed.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Raster.h>
+
+// bytes of a case, taken in order; reads past the end give 0
+class Input {
+public:
+    Input(const uint8_t *data, size_t size) : _data(data), _size(size), _pos(0) {}
+
+    bool done() const { return _pos >= _size; }
+
+    uint8_t u8() { return _pos < _size ? _data[_pos++] : 0; }
+
+    uint16_t u16() { return u8() | (u8() << 8); }
+
+    // a coordinate: mostly around the screen, sometimes far out
+    int16_t coord(int16_t size)
+    {
+        uint8_t kind = u8();
+        if (kind < 192) {
+            return (int16_t) (u16() % (size + 32)) - 16;
+        }
+        if (kind < 248) {
+            return (int16_t) (u16() % 600) - 300;
+        }
+        return (int16_t) u16();
+    }
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+    size_t _pos;
+};
+
+static int W, H;
+static Raster *lcd;
+static uint8_t *buffer;
+
+// reference screen and clip rectangle
+static bool ref[RASTER_MAX_HEIGHT][RASTER_MAX_WIDTH];
+static int clip_x0, clip_y0, clip_x1, clip_y1;
+
+// panel contents, as sent through the dirty box
+static uint8_t shown[RASTER_MAX_WIDTH * RASTER_MAX_HEIGHT / 8];
+
+static char call[256];
+
+static void fail(const char *what, int x, int y)
+{
+    fprintf(stderr, "raster_fuzz: %dx%d, clip %d,%d-%d,%d\n  %s\n  %s at %d,%d\n",
+            W, H, clip_x0, clip_y0, clip_x1, clip_y1, call, what, x, y);
+    abort();
+}
+
+static bool pixel(const uint8_t *buf, int x, int y)
+{
+    return buf[x + (y / 8) * W] & (1 << (y % 8));
+}
+
+static bool in_clip(int x, int y)
+{
+    return x >= clip_x0 && x <= clip_x1 && y >= clip_y0 && y <= clip_y1;
+}
+
+static bool combine(bool dst, bool v, uint8_t mode)
+{
+    if (mode & 0x4) {
+        v = !v;
+    }
+    switch (mode & 0x3) {
+    default:
+    case Raster::pixel_copy:
+        return v;
+    case Raster::pixel_or:
+        return dst || v;
+    case Raster::pixel_xor:
+        return dst != v;
+    case Raster::pixel_clr:
+        return dst && !v;
+    }
+}
+
+static void ref_set(long x, long y, bool v, uint8_t mode)
+{
+    if (in_clip(x, y)) {
+        ref[y][x] = combine(ref[y][x], v, mode);
+    }
+}
+
+static bool pattern_bit(const uint8_t *pattern, long x, long y)
+{
+    return pattern[y & 7] & (1 << (x & 7));
+}
+
+static void ref_set_clip(int x0, int y0, int x1, int y1)
+{
+    if (x0 > x1) {
+        int t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    if (y0 > y1) {
+        int t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    clip_x0 = x0 < 0 ? 0 : x0;
+    clip_y0 = y0 < 0 ? 0 : y0;
+    clip_x1 = x1 >= W ? W - 1 : x1;
+    clip_y1 = y1 >= H ? H - 1 : y1;
+    if (clip_x0 > clip_x1 || clip_y0 > clip_y1) {
+        clip_x0 = clip_y0 = 0;
+        clip_x1 = clip_y1 = -1;
+    }
+}
+
+static void ref_span(long x, long y0, long y1, const uint8_t *pattern, uint8_t mode)
+{
+    if (y0 > y1) {
+        long t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    for (long y = y0; y <= y1; y++) {
+        ref_set(x, y, pattern_bit(pattern, x, y), mode);
+    }
+}
+
+static void ref_hline(long x0, long x1, long y, const uint8_t *pattern, uint8_t mode)
+{
+    if (x0 > x1) {
+        long t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    for (long x = x0; x <= x1; x++) {
+        ref_set(x, y, pattern_bit(pattern, x, y), mode);
+    }
+}
+
+// native layout: rows of width column bytes, LSB on top
+static void ref_native(const uint8_t *bmp, long x, long y, int width, int height, uint8_t mode)
+{
+    for (int r = 0; r < height; r++) {
+        for (int c = 0; c < width; c++) {
+            ref_set(x + c, y + r, bmp[(r / 8) * width + c] & (1 << (r % 8)), mode);
+        }
+    }
+}
+
+// row-major, MSB first, rows padded to `pad` bits
+static void ref_rows(const uint8_t *bmp, long x, long y, int width, int height, int pad, uint8_t mode)
+{
+    int stride = (width + pad - 1) / pad * pad;
+    for (int r = 0; r < height; r++) {
+        for (int c = 0; c < width; c++) {
+            int bit = r * stride + c;
+            ref_set(x + c, y + r, bmp[bit / 8] & (0x80 >> (bit % 8)), mode);
+        }
+    }
+}
+
+static long ref_char(char ch, long x, long y, const Font &font, uint8_t mode)
+{
+    uint8_t width;
+    const uint8_t *glyph = font_glyph(font, ch, width);
+    if (!glyph) {
+        return x;
+    }
+    for (int c = 0; c < width * font.scale; c++) {
+        for (int r = 0; r < FONT_HEIGHT * font.scale; r++) {
+            ref_set(x + c, y + r, glyph[c / font.scale] & (1 << (r / font.scale)), mode);
+        }
+    }
+    return x + (width + font.spacing) * font.scale;
+}
+
+// the reference screen against the buffer, and the dirty box against the panel
+static void check(const char *what)
+{
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            if (pixel(buffer, x, y) != ref[y][x]) {
+                fail(what, x, y);
+            }
+        }
+    }
+
+    uint8_t x0, x1, b0, b1;
+    if (lcd->dirty(x0, x1, b0, b1)) {
+        if (x1 >= W || b1 >= H / 8 || x0 > x1 || b0 > b1) {
+            fail("dirty box off screen", x1, b1);
+        }
+        for (int b = b0; b <= b1; b++) {
+            memcpy(&shown[x0 + b * W], &buffer[x0 + b * W], x1 - x0 + 1);
+        }
+        lcd->mark_clean();
+    }
+    for (int i = 0; i < W * H / 8; i++) {
+        if (shown[i] != buffer[i]) {
+            fail("changed outside the dirty box", i % W, i / W * 8);
+        }
+    }
+}
+
+// the pixels a shape covers: drawn black with pixel_or on a blank copy
+static uint8_t coverage[RASTER_MAX_WIDTH * RASTER_MAX_HEIGHT / 8];
+static uint8_t saved[RASTER_MAX_WIDTH * RASTER_MAX_HEIGHT / 8];
+
+enum Shape { shape_line, shape_circle, shape_fill_circle, shape_ellipse, shape_fill_ellipse,
+             shape_rrect, shape_fill_rrect };
+
+struct ShapeArgs {
+    Shape shape;
+    int16_t x0, y0, x1, y1;
+    uint8_t a, b;
+};
+
+static void draw_shape(const ShapeArgs &s, const uint8_t *pattern, Raster::Mode mode)
+{
+    switch (s.shape) {
+    case shape_line:
+        lcd->draw_line(s.x0, s.y0, s.x1, s.y1, pattern, mode);
+        break;
+    case shape_circle:
+        lcd->draw_circle(s.x0, s.y0, s.a, pattern, mode);
+        break;
+    case shape_fill_circle:
+        lcd->fill_circle(s.x0, s.y0, s.a, pattern, mode);
+        break;
+    case shape_ellipse:
+        lcd->draw_ellipse(s.x0, s.y0, s.a, s.b, pattern, mode);
+        break;
+    case shape_fill_ellipse:
+        lcd->fill_ellipse(s.x0, s.y0, s.a, s.b, pattern, mode);
+        break;
+    case shape_rrect:
+        lcd->draw_rrect(s.x0, s.y0, s.x1, s.y1, s.a, pattern, mode);
+        break;
+    case shape_fill_rrect:
+        lcd->fill_rrect(s.x0, s.y0, s.x1, s.y1, s.a, pattern, mode);
+        break;
+    }
+}
+
+static void cover(const ShapeArgs &s, uint8_t *out)
+{
+    lcd->save_buffer((uint32_t *) saved);
+    lcd->clear_buffer();
+    draw_shape(s, Raster::pattern_black, Raster::pixel_or);
+    memcpy(out, buffer, W * H / 8);
+    lcd->load_buffer((const uint32_t *) saved);
+}
+
+// where (x, y) is against the ellipse of radii a, b centered on the origin,
+// 1 on its outline; a flat ellipse is a line
+static double ellipse_level(double x, double y, double a, double b)
+{
+    return (a > 0 ? x * x / (a * a) : (x ? 1e9 : 0)) + (b > 0 ? y * y / (b * b) : (y ? 1e9 : 0));
+}
+
+// distance from a point to the rectangle cx0,cy0 - cx1,cy1, per axis
+static void outside(long x, long y, long cx0, long cy0, long cx1, long cy1, double &dx, double &dy)
+{
+    dx = x < cx0 ? cx0 - x : (x > cx1 ? x - cx1 : 0);
+    dy = y < cy0 ? cy0 - y : (y > cy1 ? y - cy1 : 0);
+}
+
+static void check_shape(const ShapeArgs &s)
+{
+    bool fill = s.shape == shape_fill_circle || s.shape == shape_fill_ellipse || s.shape == shape_fill_rrect;
+
+    // centers of the quarter arcs and the radii, as the shape is defined
+    long cx0 = s.x0, cy0 = s.y0, cx1 = s.x0, cy1 = s.y0;
+    double a = s.a, b = s.shape == shape_ellipse || s.shape == shape_fill_ellipse ? s.b : s.a;
+    if (s.shape == shape_rrect || s.shape == shape_fill_rrect) {
+        long x0 = s.x0 < s.x1 ? s.x0 : s.x1, x1 = s.x0 < s.x1 ? s.x1 : s.x0;
+        long y0 = s.y0 < s.y1 ? s.y0 : s.y1, y1 = s.y0 < s.y1 ? s.y1 : s.y0;
+        long r = s.a;
+        if (r > (x1 - x0) / 2) {
+            r = (x1 - x0) / 2;
+        }
+        if (r > (y1 - y0) / 2) {
+            r = (y1 - y0) / 2;
+        }
+        a = b = r;
+        cx0 = x0 + r;
+        cy0 = y0 + r;
+        cx1 = x1 - r;
+        cy1 = y1 - r;
+    }
+
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            bool on = pixel(coverage, x, y);
+            if (on && !in_clip(x, y)) {
+                fail("drawn outside the clip rectangle", x, y);
+            }
+            if (s.shape == shape_line) {
+                continue; // compared with bresenham() as a whole
+            }
+
+            // a covered pixel's square touches the ideal shape, and a pixel
+            // whose square is wholly inside is covered by a filled shape
+            double dx, dy;
+            outside(x, y, cx0, cy0, cx1, cy1, dx, dy);
+            double nx = dx > 0.5 ? dx - 0.5 : 0, ny = dy > 0.5 ? dy - 0.5 : 0;
+            if (on && ellipse_level(nx, ny, a, b) > 1.0 + 1e-9) {
+                fail("pixel outside the shape", x, y);
+            }
+            if (fill && !on && in_clip(x, y) && ellipse_level(dx + 0.5, dy + 0.5, a, b) < 1.0 - 1e-9) {
+                fail("hole in a filled shape", x, y);
+            }
+        }
+    }
+}
+
+// the whole line, keeping the pixels inside the clip rectangle
+static void bresenham(long x0, long y0, long x1, long y1, uint8_t *out)
+{
+    memset(out, 0, W * H / 8);
+    long dx = labs(x1 - x0), dy = labs(y1 - y0);
+    long sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    long x = x0, y = y0;
+    if (dx > dy) {
+        long d = 2 * dy - dx;
+        for (long i = 0; i <= dx; i++, x += sx) {
+            if (in_clip(x, y)) {
+                out[x + (y / 8) * W] |= 1 << (y % 8);
+            }
+            if (d > 0) {
+                y += sy;
+                d -= 2 * dx;
+            }
+            d += 2 * dy;
+        }
+    } else {
+        long d = 2 * dx - dy;
+        for (long i = 0; i <= dy; i++, y += sy) {
+            if (in_clip(x, y)) {
+                out[x + (y / 8) * W] |= 1 << (y % 8);
+            }
+            if (d > 0) {
+                x += sx;
+                d -= 2 * dy;
+            }
+            d += 2 * dx;
+        }
+    }
+}
+
+static const uint8_t *patterns[5] = {
+    Raster::pattern_black, Raster::pattern_dkgrey, Raster::pattern_grey,
+    Raster::pattern_ltgrey, Raster::pattern_white
+};
+
+// runs of 2..129 and literals of 1..128 bytes, as tools/bmpconv.cpp packs them
+static size_t rle_pack(const uint8_t *in, size_t size, uint8_t *out)
+{
+    size_t len = 0, i = 0;
+    while (i < size) {
+        size_t run = 1;
+        while (i + run < size && run < 129 && in[i + run] == in[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            out[len++] = LCD_RLE_RUN | (run - 2);
+            out[len++] = in[i];
+            i += run;
+            continue;
+        }
+        size_t start = i++;
+        while (i < size && i - start < 128 && !(i + 1 < size && in[i] == in[i + 1])) {
+            i++;
+        }
+        out[len++] = i - start - 1;
+        memcpy(out + len, in + start, i - start);
+        len += i - start;
+    }
+    return len;
+}
+
+static void run_case(const uint8_t *data, size_t size)
+{
+    Input in(data, size);
+    W = (in.u8() & 1) ? 128 : 84;
+    H = (W == 128) ? 64 : 48;
+
+    // exact size, so AddressSanitizer sees any write past the end
+    uint32_t *words = (uint32_t *) malloc(W * H / 8);
+    buffer = (uint8_t *) words;
+    Raster raster(words, W, H);
+    lcd = &raster;
+
+    lcd->clear_buffer();
+    memset(ref, 0, sizeof(ref));
+    memset(shown, 0xA5, sizeof(shown));
+    ref_set_clip(0, 0, W - 1, H - 1);
+    snprintf(call, sizeof(call), "clear_buffer()");
+    check("clear");
+
+    static uint8_t bmp[512];
+    static uint8_t packed[1024];
+    static char text[24];
+    static RasterLayer<RASTER_MAX_WIDTH, RASTER_MAX_HEIGHT> layer_a, layer_b;
+
+    for (int steps = 0; !in.done() && steps < 64; steps++) {
+        uint8_t op = in.u8() % 24;
+        Raster::Mode mode = (Raster::Mode) (in.u8() & 7);
+        const uint8_t *pattern = patterns[in.u8() % 5];
+        int16_t x0 = in.coord(W), y0 = in.coord(H), x1 = in.coord(W), y1 = in.coord(H);
+        uint8_t a = in.u8(), b = in.u8();
+        if (in.u8() & 1) {
+            // most shapes fit on the screen
+            a %= 40;
+            b %= 40;
+        }
+
+        switch (op) {
+        case 0: {
+            bool v = a & 1;
+            snprintf(call, sizeof(call), "draw_pixel(%d, %d, %d, %d)", x0, y0, v, mode);
+            lcd->draw_pixel(x0, y0, v, mode);
+            ref_set(x0, y0, v, mode);
+            break;
+        }
+        case 1:
+            snprintf(call, sizeof(call), "draw_hline(%d, %d, %d, mode %d)", x0, x1, y0, mode);
+            lcd->draw_hline(x0, x1, y0, pattern, mode);
+            ref_hline(x0, x1, y0, pattern, mode);
+            break;
+        case 2:
+            snprintf(call, sizeof(call), "draw_vline(%d, %d, %d, mode %d)", y0, y1, x0, mode);
+            lcd->draw_vline(y0, y1, x0, pattern, mode);
+            ref_span(x0, y0, y1, pattern, mode);
+            break;
+        case 3: {
+            snprintf(call, sizeof(call), "fill_rect(%d, %d, %d, %d, mode %d)", x0, y0, x1, y1, mode);
+            lcd->fill_rect(x0, y0, x1, y1, pattern, mode);
+            long lo = x0 < x1 ? x0 : x1, hi = x0 < x1 ? x1 : x0;
+            for (long x = lo; x <= hi; x++) {
+                ref_span(x, y0, y1, pattern, mode);
+            }
+            break;
+        }
+        case 4:
+            snprintf(call, sizeof(call), "draw_rect(%d, %d, %d, %d, mode %d)", x0, y0, x1, y1, mode);
+            lcd->draw_rect(x0, y0, x1, y1, pattern, mode);
+            ref_hline(x0, x1, y0, pattern, mode);
+            ref_hline(x0, x1, y1, pattern, mode);
+            ref_span(x0, y0, y1, pattern, mode);
+            ref_span(x1, y0, y1, pattern, mode);
+            break;
+        case 5: case 6: case 7: case 8: case 9: case 10: case 11: {
+            static const char *names[] = {"draw_line", "draw_circle", "fill_circle", "draw_ellipse",
+                                          "fill_ellipse", "draw_rrect", "fill_rrect"};
+            ShapeArgs s = {(Shape) (op - 5), x0, y0, x1, y1, a, b};
+            snprintf(call, sizeof(call), "%s(%d, %d, %d, %d, a %d, b %d, mode %d)",
+                     names[op - 5], x0, y0, x1, y1, a, b, mode);
+            cover(s, coverage);
+            check_shape(s);
+            if (s.shape == shape_line) {
+                static uint8_t line[sizeof(coverage)];
+                bresenham(x0, y0, x1, y1, line);
+                if (memcmp(line, coverage, W * H / 8)) {
+                    fail("line is not Bresenham's", x0, y0);
+                }
+            }
+            if (s.shape == shape_circle || s.shape == shape_ellipse || s.shape == shape_rrect) {
+                // the outline is part of the filled shape
+                static uint8_t filled[sizeof(coverage)];
+                ShapeArgs f = s;
+                f.shape = (Shape) (s.shape + 1);
+                cover(f, filled);
+                for (int i = 0; i < W * H / 8; i++) {
+                    if (coverage[i] & ~filled[i]) {
+                        fail("outline outside its filled shape", i % W, i / W * 8);
+                    }
+                }
+            }
+            // any mode is that mode applied once to each covered pixel
+            draw_shape(s, pattern, mode);
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    if (pixel(coverage, x, y)) {
+                        ref[y][x] = combine(ref[y][x], pattern_bit(pattern, x, y), mode);
+                    }
+                }
+            }
+            break;
+        }
+        case 12: {
+            uint8_t w = a % 48 + 1, h = b % 40 + 1;
+            for (int i = 0; i < w * ((h + 7) / 8); i++) {
+                bmp[i] = in.u8();
+            }
+            snprintf(call, sizeof(call), "blit_bitmap(%d, %d, %dx%d, mode %d)", x0, y0, w, h, mode);
+            lcd->blit_bitmap(bmp, x0, y0, w, h, mode);
+            ref_native(bmp, x0, y0, w, h, mode);
+            break;
+        }
+        case 13: {
+            uint8_t w = a % 48 + 1, h = b % 40 + 1;
+            for (int i = 0; i < (w * h + 7) / 8; i++) {
+                bmp[i] = in.u8();
+            }
+            snprintf(call, sizeof(call), "draw_bitmap(%d, %d, %dx%d, mode %d)", x0, y0, w, h, mode);
+            lcd->draw_bitmap(bmp, x0, y0, w, h, mode);
+            ref_rows(bmp, x0, y0, w, h, 1, mode);
+            break;
+        }
+        case 14: {
+            uint8_t w = a % 48 + 1, h = b % 40 + 1;
+            bmp[0] = bmp[1] = 0;
+            bmp[2] = w;
+            bmp[3] = h;
+            for (int i = 0; i < (w + 7) / 8 * h; i++) {
+                bmp[4 + i] = in.u8();
+            }
+            snprintf(call, sizeof(call), "draw_wbitmap(%d, %d, %dx%d, mode %d)", x0, y0, w, h, mode);
+            lcd->draw_wbitmap(bmp, x0, y0, mode);
+            ref_rows(bmp + 4, x0, y0, w, h, 8, mode);
+            break;
+        }
+        case 15: {
+            // runs are likely: each byte repeats the previous one half the time
+            uint8_t w = a % 48 + 1, h = b % 40 + 1;
+            if (x1 & 1) {
+                x0 &= ~7;
+                y0 &= ~7;
+                h = (h + 7) & ~7;
+            }
+            int n = w * ((h + 7) / 8);
+            for (int i = 0; i < n; i++) {
+                uint8_t r = in.u8();
+                bmp[i] = (i && (r & 1)) ? bmp[i - 1] : in.u8();
+            }
+            rle_pack(bmp, n, packed);
+            snprintf(call, sizeof(call), "blit_rle(%d, %d, %dx%d, mode %d)", x0, y0, w, h, mode);
+            lcd->blit_rle(packed, x0, y0, w, h, mode);
+            ref_native(bmp, x0, y0, w, h, mode);
+            break;
+        }
+        case 16: {
+            const Font *fonts[] = {&font_fixed, &font_small, &font_large};
+            const Font &font = *fonts[a % 3];
+            uint8_t len = b % (sizeof(text) - 1);
+            for (uint8_t i = 0; i < len; i++) {
+                text[i] = 32 + in.u8() % 100; // a few past the table too
+            }
+            text[len] = '\0';
+            snprintf(call, sizeof(call), "print_string(\"%s\", %d, %d, font %d, mode %d)", text, x0, y0, a % 3, mode);
+            long x = (a % 3 == 0 && (b & 0x80)) ? lcd->print_string(text, x0, y0, -1, mode)
+                                                : lcd->print_string(text, x0, y0, font, mode);
+            long rx = x0;
+            for (const char *c = text; *c && rx <= clip_x1; c++) {
+                rx = ref_char(*c, rx, y0, font, mode);
+            }
+            if ((int16_t) rx != x) {
+                fail("print_string returned another column", x, rx);
+            }
+            break;
+        }
+        case 17: {
+            uint8_t sx = a % (W + 8), sy = b % (H + 8), w = in.u8() % (W + 8), h = in.u8() % (H + 8);
+            snprintf(call, sizeof(call), "copy_region(%d, %d, %d, %d, %d, %d, mode %d)", sx, sy, w, h, x0, y0, mode);
+            lcd->copy_region(sx, sy, w, h, x0, y0, mode);
+            if (sx < W && sy < H) {
+                static bool src[RASTER_MAX_HEIGHT][RASTER_MAX_WIDTH];
+                memcpy(src, ref, sizeof(src));
+                for (int c = 0; c < w && sx + c < W; c++) {
+                    for (int r = 0; r < h && sy + r < H; r++) {
+                        ref_set(x0 + c, y0 + r, src[sy + r][sx + c], mode);
+                    }
+                }
+            }
+            break;
+        }
+        case 18: {
+            int8_t d = (int8_t) a;
+            bool vert = b & 1;
+            snprintf(call, sizeof(call), "scroll_%s(%d)", vert ? "vert" : "horiz", d);
+            static bool src[RASTER_MAX_HEIGHT][RASTER_MAX_WIDTH];
+            memcpy(src, ref, sizeof(src));
+            if (vert) {
+                lcd->scroll_vert(d);
+            } else {
+                lcd->scroll_horiz(d);
+            }
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    int fx = vert ? x : x - d, fy = vert ? y - d : y;
+                    ref[y][x] = fx >= 0 && fx < W && fy >= 0 && fy < H && src[fy][fx];
+                }
+            }
+            break;
+        }
+        case 19:
+            snprintf(call, sizeof(call), "fill_buffer(pattern %d)", (int) (pattern[0]));
+            lcd->fill_buffer(pattern);
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    ref[y][x] = pattern_bit(pattern, x, y);
+                }
+            }
+            break;
+        case 20:
+            snprintf(call, sizeof(call), "invert_buffer()");
+            lcd->invert_buffer();
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    ref[y][x] = !ref[y][x];
+                }
+            }
+            break;
+        case 21: {
+            // a layer of random bytes, combined alone or over the saved screen
+            static bool fg[RASTER_MAX_HEIGHT][RASTER_MAX_WIDTH], bg[RASTER_MAX_HEIGHT][RASTER_MAX_WIDTH];
+            for (int i = 0; i < W * H / 8; i++) {
+                layer_a.bytes[i] = (i % 7 == (a & 7)) ? in.u8() : layer_a.bytes[i] ^ b;
+            }
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    fg[y][x] = layer_a.bytes[x + (y / 8) * W] & (1 << (y % 8));
+                }
+            }
+            memcpy(bg, ref, sizeof(bg));
+            lcd->save_buffer(layer_b);
+            bool two = x1 & 1;
+            snprintf(call, sizeof(call), "composite(%s, mode %d)", two ? "bg, fg" : "fg", mode);
+            if (two) {
+                lcd->clear_buffer();
+                lcd->composite(layer_b, layer_a, mode);
+            } else {
+                lcd->composite(layer_a, mode);
+            }
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    ref[y][x] = combine(bg[y][x], fg[y][x], mode);
+                }
+            }
+            break;
+        }
+        case 22: {
+            uint8_t col = a % (W + 4), bank = b % (H / 8 + 2), byte = in.u8();
+            snprintf(call, sizeof(call), "draw_byte(%d, %d, 0x%02X)", col, bank, byte);
+            lcd->draw_byte(col, bank, byte);
+            if (col < W && bank < H / 8) {
+                for (int r = 0; r < 8; r++) {
+                    ref[bank * 8 + r][col] = byte & (1 << r);
+                }
+            }
+            if (lcd->get_byte(col, bank) != ((col < W && bank < H / 8) ? byte : 0)) {
+                fail("get_byte disagrees", col, bank);
+            }
+            break;
+        }
+        case 23:
+            if (a & 1) {
+                snprintf(call, sizeof(call), "reset_clip()");
+                lcd->reset_clip();
+                ref_set_clip(0, 0, W - 1, H - 1);
+            } else {
+                snprintf(call, sizeof(call), "set_clip(%d, %d, %d, %d)", x0, y0, x1, y1);
+                lcd->set_clip(x0, y0, x1, y1);
+                ref_set_clip(x0, y0, x1, y1);
+            }
+            break;
+        }
+        check("pixel differs from the reference");
+
+        if (!lcd->get_pixel(x0, y0) != !(x0 >= 0 && x0 < W && y0 >= 0 && y0 < H && ref[y0][x0])) {
+            fail("get_pixel disagrees", x0, y0);
+        }
+    }
+
+    free(words);
+}
+
+#ifdef RASTER_FUZZ_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    run_case(data, size);
+    return 0;
+}
+
+#else
+
+static uint32_t rng;
+
+// xorshift32, the same generator as the game
+static uint32_t next()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+int main(int argc, char **argv)
+{
+    long cases = argc > 1 ? atol(argv[1]) : 20000;
+    rng = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    if (!rng) {
+        rng = 1;
+    }
+
+    static uint8_t data[4096];
+    for (long n = 0; n < cases; n++) {
+        size_t size = next() % sizeof(data);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = next();
+        }
+        run_case(data, size);
+    }
+    printf("%ld cases, no mismatch\n", cases);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Reproduce en el host una partida grabada por ReplayRecorder
+**
+** Build:  g++ -O2 -I../lib/Snake replay.cpp ../lib/Snake/Replay.cpp -o replay
+** Usage:  replay [-s speed] [-v] replay-0.bin
+**
+**   -s speed  play at `speed` times real time and draw the board on the
+**             terminal; 0 (the default) runs headless as fast as possible
+**   -v        print the head position and direction of every step
+**
+** The game is rebuilt from the recorded seed, mode and turns with the rules
+** from lib/Snake; the final score and tick count are checked against the values
+** stored in the log. The mode is printed as fruits/walls/obstacles.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <SnakeGame.h>
+#include <Replay.h>
+
+static SnakeGame game;
+
+static void draw_board()
+{
+    static char rows[SNAKE_HEIGHT + 2][SNAKE_WIDTH + 3];
+    // by cell_type; the border is outside the board, so a wall
+    static const char cells[] = " *#xo";
+
+    for (int y = 0; y < SNAKE_HEIGHT + 2; y++) {
+        for (int x = 0; x < SNAKE_WIDTH + 2; x++) {
+            rows[y][x] = cells[game.cell(x, y)];
+        }
+        rows[y][SNAKE_WIDTH + 2] = '\0';
+    }
+    if (game.head.x >= 0 && game.head.x <= SNAKE_WIDTH + 1 && game.head.y >= 0 && game.head.y <= SNAKE_HEIGHT + 1) {
+        rows[game.head.y][game.head.x] = '@';
+    }
+
+    printf("\033[H");
+    for (int y = 0; y < SNAKE_HEIGHT + 2; y++) {
+        puts(rows[y]);
+    }
+    printf("score %d\n", game.score);
+}
+
+int main(int argc, char **argv)
+{
+    double speed = 0;
+    bool verbose = false;
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            speed = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "-v")) {
+            verbose = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s [-s speed] [-v] replay.bin\n", argv[0]);
+        return 1;
+    }
+
+    static uint8_t log[REPLAY_BUFFER];
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        return 1;
+    }
+    size_t size = fread(log, 1, sizeof(log), in);
+    fclose(in);
+
+    ReplayPlayer player;
+    if (!player.load(log, size)) {
+        fprintf(stderr, "%s: not a version %d replay log\n", path, REPLAY_VERSION);
+        return 1;
+    }
+
+    game.set_mode(player.mode());
+    game.seed(player.seed());
+    game.reset();
+    if (speed > 0) {
+        printf("\033[2J");
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    uint32_t ticks = 0;
+    while (!player.done() && game.game_state == run) {
+        game.turn(player.tick());
+        if (verbose) {
+            printf("%u head %d,%d dir %d\n", ticks, game.head.x, game.head.y, game.dir);
+        }
+        game.step();
+        ticks++;
+
+        if (speed > 0) {
+            draw_board();
+            struct timespec nap;
+            double s = game.period / speed;
+            nap.tv_sec = (time_t) s;
+            nap.tv_nsec = (long) ((s - nap.tv_sec) * 1e9);
+            nanosleep(&nap, NULL);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    bool ok = ticks == player.total_ticks() && game.score == player.score();
+    const GameMode &mode = player.mode();
+    printf("seed %u, mode %d/%d/%d, %u ticks, score %d (recorded %u ticks, score %d) in %.3f ms: %s\n",
+           player.seed(), mode.fruits, mode.walls, mode.obstacles, ticks, game.score,
+           player.total_ticks(), player.score(), secs * 1e3, ok ? "OK" : "MISMATCH");
+    return ok ? 0 : 1;
+}
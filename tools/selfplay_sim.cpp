@@ -0,0 +1,206 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Simulador de partidas en paralelo para ajustar la curva de velocidad
+**
+** Build:  g++ -O2 -std=c++11 -pthread -I../lib/Snake -I../lib/Autopilot selfplay_sim.cpp \
+**             ../lib/Autopilot/Autopilot.cpp -o selfplay_sim
+** Usage:  selfplay_sim [-g games] [-t threads] [-r reaction_ms] [-c start,step,min]...
+**
+** Plays `games` seeded games for every speed curve given with -c (the game's
+** default curve when none is given) using the game rules from lib/Snake. The
+** player is the BFS autopilot limited to human speed: after a turn it cannot
+** turn again until `reaction_ms` of game time have passed, so at high tick
+** rates it misses the quick turns the board asks for and crashes sooner.
+**
+** Games still running after MAX_TICKS ticks (the autopilot looping without
+** reaching the fruit) are cut and counted apart: they are left out of the
+** score, tick, seconds and tick rate figures, which describe the games that
+** ended.
+**
+** Seeds are handed out to the worker threads in small chunks through a shared
+** atomic counter, so a thread that finishes short games keeps taking work
+** until the sweep is done and every core stays busy.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <SnakeGame.h>
+#include <Autopilot.h>
+
+#define CHUNK 16
+#define MAX_TICKS 50000 // games still running are cut and counted apart
+#define RATE_BINS 10 // ticks per second histogram, 5 tick/s wide bins
+
+struct GameResult {
+    int score;
+    bool cut; // still running at MAX_TICKS
+    long ticks;
+    double seconds;
+    long rate_ticks[RATE_BINS]; // ticks played in each tick rate bin
+};
+
+struct Worker {
+    SnakeGame game;
+    Autopilot pilot;
+};
+
+static void play(Worker &w, const SpeedCurve &curve, uint32_t seed, int reaction_ms, GameResult &res)
+{
+    SnakeGame &game = w.game;
+    double reaction = reaction_ms / 1000.0;
+    double since_turn = reaction;
+
+    game.set_speed(curve);
+    game.seed(seed);
+    game.reset();
+    w.pilot.reset();
+
+    memset(&res, 0, sizeof(res));
+    for (long t = 0; t < MAX_TICKS && game.game_state == run; t++) {
+        directions want = w.pilot.next(game);
+        if (want != game.dir && since_turn >= reaction) {
+            game.turn(want);
+            since_turn = 0;
+        }
+        since_turn += game.period;
+
+        int bin = (int) (1.0f / game.period / 5.0f);
+        res.rate_ticks[std::min(bin, RATE_BINS - 1)]++;
+        res.seconds += game.period;
+        res.ticks++;
+
+        game.step();
+    }
+    res.score = game.score;
+    res.cut = game.game_state == run;
+}
+
+static double percentile(std::vector<double> v, double p)
+{
+    std::sort(v.begin(), v.end());
+    return v[(size_t) ((v.size() - 1) * p)];
+}
+
+int main(int argc, char **argv)
+{
+    int games = 10000;
+    int threads = std::thread::hardware_concurrency();
+    int reaction_ms = 200;
+    std::vector<SpeedCurve> curves;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            games = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            reaction_ms = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            SpeedCurve c;
+            if (sscanf(argv[++i], "%f,%f,%f", &c.start, &c.step, &c.min) != 3 || c.min <= 0) {
+                fprintf(stderr, "bad curve %s, expected start,step,min in seconds\n", argv[i]);
+                return 1;
+            }
+            curves.push_back(c);
+        } else {
+            fprintf(stderr, "usage: %s [-g games] [-t threads] [-r reaction_ms] [-c start,step,min]...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (curves.empty()) {
+        curves.push_back(SnakeGame::default_speed);
+    }
+    threads = std::max(threads, 1);
+
+    // one job per (curve, seed), all curves share the pool
+    long jobs = (long) games * curves.size();
+    std::vector<GameResult> results(jobs);
+    std::atomic<long> next_job(0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.push_back(std::thread([&]() {
+            Worker *w = new Worker(); // too big for a thread stack
+            long begin;
+            while ((begin = next_job.fetch_add(CHUNK)) < jobs) {
+                long end = std::min(begin + CHUNK, jobs);
+                for (long j = begin; j < end; j++) {
+                    play(*w, curves[j / games], (uint32_t) (j % games) + 1, reaction_ms, results[j]);
+                }
+            }
+            delete w;
+        }));
+    }
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    long total_ticks = 0;
+    for (size_t c = 0; c < curves.size(); c++) {
+        std::vector<double> scores, ticks, seconds;
+        long rate[RATE_BINS] = {0};
+        long curve_ticks = 0;
+        long cut_ticks = 0;
+        int cut = 0;
+
+        for (int g = 0; g < games; g++) {
+            const GameResult &r = results[c * games + g];
+            total_ticks += r.ticks;
+            if (r.cut) {
+                cut++;
+                cut_ticks += r.ticks;
+                continue;
+            }
+            scores.push_back(r.score);
+            ticks.push_back(r.ticks);
+            seconds.push_back(r.seconds);
+            for (int b = 0; b < RATE_BINS; b++) {
+                rate[b] += r.rate_ticks[b];
+            }
+            curve_ticks += r.ticks;
+        }
+
+        printf("curve start %.3f s  step %.4f s  min %.3f s\n", curves[c].start, curves[c].step, curves[c].min);
+        printf("  games cut at %d ticks: %d (%.1f%% of the ticks played), left out below\n", MAX_TICKS, cut,
+               100.0 * cut_ticks / std::max(curve_ticks + cut_ticks, 1L));
+        if (scores.empty()) {
+            continue;
+        }
+        printf("  score    p10 %5.0f  p50 %5.0f  p90 %5.0f  max %5.0f\n",
+               percentile(scores, 0.1), percentile(scores, 0.5), percentile(scores, 0.9), percentile(scores, 1.0));
+        printf("  ticks    p10 %5.0f  p50 %5.0f  p90 %5.0f  max %5.0f\n",
+               percentile(ticks, 0.1), percentile(ticks, 0.5), percentile(ticks, 0.9), percentile(ticks, 1.0));
+        printf("  seconds  p10 %5.0f  p50 %5.0f  p90 %5.0f  max %5.0f\n",
+               percentile(seconds, 0.1), percentile(seconds, 0.5), percentile(seconds, 0.9), percentile(seconds, 1.0));
+        printf("  tick rate histogram (share of ticks)\n");
+        for (int b = 0; b < RATE_BINS; b++) {
+            if (!rate[b]) {
+                continue;
+            }
+            double share = (double) rate[b] / curve_ticks;
+            if (b == RATE_BINS - 1) {
+                printf("    %2d+    tick/s %5.1f%% ", b * 5, 100.0 * share);
+            } else {
+                printf("    %2d-%2d  tick/s %5.1f%% ", b * 5, b * 5 + 5, 100.0 * share);
+            }
+            for (int i = 0; i < (int) (share * 50); i++) {
+                putchar('#');
+            }
+            putchar('\n');
+        }
+    }
+
+    printf("%ld games, %ld ticks on %d threads in %.2f s (%.1f M ticks/s)\n",
+           jobs, total_ticks, threads, wall, total_ticks / wall / 1e6);
+    return 0;
+}
@@ -0,0 +1,484 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Dibuja en el host cada primitiva de Raster en cada modo y guarda o compara
+** las imagenes (PBM)
+**
+** Build:  g++ -O2 -I../lib/Nokia5110 -I../lib/Snake snapshot.cpp ../lib/Nokia5110/Raster.cpp \
+**             ../lib/Nokia5110/Font.cpp ../lib/Nokia5110/TileMap.cpp -o snapshot
+** Usage:  snapshot [-s WxH] [-p prefix] -w dir | -c dir | -W sums | -C sums
+**
+**   -s WxH     screen size, 84x48 (the default, Nokia 5110) or up to 128x64
+**   -p prefix  only the scenes whose name starts with prefix
+**   -w dir     write one binary PBM (P4) per scene and mode to dir
+**   -c dir     draw again and compare byte for byte with the images in dir
+**   -W sums    write a manifest: one line per image with its FNV-1a hash
+**   -C sums    draw again and compare with the hashes in the manifest
+**
+** The golden manifests for both screen sizes are committed next to this file
+** and every drawing change is checked against them, from tools/:
+**
+**   ./snapshot -C snapshot_84x48.sums && ./snapshot -s 128x64 -C snapshot_128x64.sums
+**
+** A scene that differs is named; to see how, write the images with the
+** previous code (git stash) to a directory with -w, then compare with -c, which
+** gives the first differing byte, and open both PBMs. When the change is
+** meant to alter the images, write the manifests again with -W and commit
+** them with the change, so the review shows which scenes moved.
+**
+** A scene is drawn on a grey background so the 8 modes give 8 different
+** images; the files are named scene-mode.pbm and open in any image viewer
+** (and in bmpconv).
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Raster.h>
+#include <TileMap.h>
+#include <SnakeTiles.h>
+
+static RasterLayer<RASTER_MAX_WIDTH, RASTER_MAX_HEIGHT> storage;
+
+static const char *mode_names[8] = {
+    "copy", "or", "xor", "clr", "invt", "nor", "xnor", "nclr"
+};
+
+// a 12x12 native layout bitmap (a ring) and the same packed for blit_rle
+static const uint8_t ring[24] = {
+    0xF0, 0xFC, 0x0E, 0x06, 0x03, 0x03, 0x03, 0x03, 0x06, 0x0E, 0xFC, 0xF0,
+    0x00, 0x03, 0x07, 0x06, 0x0C, 0x0C, 0x0C, 0x0C, 0x06, 0x07, 0x03, 0x00
+};
+static const uint8_t stripes_rle[] = {
+    0x80 | 6, 0xAA, 3, 0xFF, 0x81, 0x81, 0xFF, 0x80 | 12, 0x0F
+};
+
+// draw_bitmap() data: 10x6 arrow, row-major MSB first
+static const uint8_t arrow[8] = {
+    0x04, 0x01, 0x80, 0x7F, 0xF0, 0x06, 0x00, 0x00
+};
+
+typedef void (*scene_fn)(Raster &lcd, Raster::Mode mode);
+
+static void scene_pixel(Raster &lcd, Raster::Mode mode)
+{
+    for (int16_t i = -4; i < lcd.width() + 4; i += 3) {
+        lcd.draw_pixel(i, i / 2, true, mode);
+        lcd.draw_pixel(i, lcd.height() - 1 - i / 3, Raster::pattern_grey, mode);
+    }
+}
+
+static void scene_hline(Raster &lcd, Raster::Mode mode)
+{
+    for (int16_t y = -2; y < lcd.height() + 2; y += 5) {
+        lcd.draw_hline(y - 10, lcd.width() - y, y, Raster::pattern_black, mode);
+        lcd.draw_hline(lcd.width() + 5, 3 * y, y + 2, Raster::pattern_dkgrey, mode);
+    }
+}
+
+static void scene_vline(Raster &lcd, Raster::Mode mode)
+{
+    for (int16_t x = -2; x < lcd.width() + 2; x += 7) {
+        lcd.draw_vline(x / 3 - 5, lcd.height() - x / 4, x, Raster::pattern_black, mode);
+        lcd.draw_vline(lcd.height() + 3, x / 2, x + 3, Raster::pattern_ltgrey, mode);
+    }
+}
+
+static void scene_line(Raster &lcd, Raster::Mode mode)
+{
+    int16_t cx = lcd.width() / 2;
+    int16_t cy = lcd.height() / 2;
+    for (int16_t a = -60; a <= 60; a += 12) {
+        lcd.draw_line(cx, cy, cx + a, cy - 40, Raster::pattern_black, mode);
+        lcd.draw_line(cx - 70, cy + a / 3, cx + 70, cy - a / 2, Raster::pattern_black, mode);
+    }
+    lcd.draw_line(-100, -100, 200, 150, Raster::pattern_grey, mode);
+}
+
+static void scene_rect(Raster &lcd, Raster::Mode mode)
+{
+    for (int16_t i = 0; i < 6; i++) {
+        lcd.draw_rect(i * 9 - 4, i * 5 - 3, i * 13 + 10, i * 9 + 6, Raster::pattern_black, mode);
+    }
+    lcd.draw_rect(lcd.width() - 10, lcd.height() - 8, lcd.width() + 10, lcd.height() + 5,
+                  Raster::pattern_dkgrey, mode);
+}
+
+static void scene_fill_rect(Raster &lcd, Raster::Mode mode)
+{
+    lcd.fill_rect(3, 2, 30, 21, Raster::pattern_black, mode);
+    lcd.fill_rect(25, 13, 60, 37, Raster::pattern_grey, mode);
+    lcd.fill_rect(-6, 30, 12, 70, Raster::pattern_dkgrey, mode);
+    lcd.fill_rect(lcd.width() + 4, 5, lcd.width() - 20, 17, Raster::pattern_ltgrey, mode);
+}
+
+static void scene_rrect(Raster &lcd, Raster::Mode mode)
+{
+    lcd.draw_rrect(2, 2, 40, 25, 6, Raster::pattern_black, mode);
+    lcd.draw_rrect(30, 10, 80, 44, 12, Raster::pattern_black, mode);
+    lcd.draw_rrect(-10, 30, 15, 60, 30, Raster::pattern_grey, mode);
+}
+
+static void scene_fill_rrect(Raster &lcd, Raster::Mode mode)
+{
+    lcd.fill_rrect(2, 2, 40, 25, 6, Raster::pattern_black, mode);
+    lcd.fill_rrect(30, 10, 80, 44, 12, Raster::pattern_grey, mode);
+    lcd.fill_rrect(-10, 30, 15, 60, 30, Raster::pattern_dkgrey, mode);
+}
+
+static void scene_circle(Raster &lcd, Raster::Mode mode)
+{
+    for (uint8_t r = 0; r < 30; r += 4) {
+        lcd.draw_circle(lcd.width() / 2, lcd.height() / 2, r, Raster::pattern_black, mode);
+    }
+    lcd.draw_circle(0, 0, 20, Raster::pattern_black, mode);
+    lcd.draw_circle(lcd.width(), lcd.height(), 200, Raster::pattern_black, mode);
+}
+
+static void scene_fill_circle(Raster &lcd, Raster::Mode mode)
+{
+    lcd.fill_circle(20, 20, 15, Raster::pattern_black, mode);
+    lcd.fill_circle(50, 30, 22, Raster::pattern_grey, mode);
+    lcd.fill_circle(lcd.width() - 3, 3, 9, Raster::pattern_dkgrey, mode);
+    lcd.fill_circle(10, 44, 1, Raster::pattern_black, mode);
+}
+
+static void scene_ellipse(Raster &lcd, Raster::Mode mode)
+{
+    lcd.draw_ellipse(lcd.width() / 2, lcd.height() / 2, 40, 20, Raster::pattern_black, mode);
+    lcd.draw_ellipse(lcd.width() / 2, lcd.height() / 2, 10, 22, Raster::pattern_black, mode);
+    lcd.draw_ellipse(15, 10, 25, 0, Raster::pattern_black, mode);
+    lcd.draw_ellipse(70, 40, 0, 12, Raster::pattern_black, mode);
+}
+
+static void scene_fill_ellipse(Raster &lcd, Raster::Mode mode)
+{
+    lcd.fill_ellipse(25, 20, 22, 12, Raster::pattern_black, mode);
+    lcd.fill_ellipse(55, 28, 14, 30, Raster::pattern_grey, mode);
+    lcd.fill_ellipse(80, 6, 30, 4, Raster::pattern_dkgrey, mode);
+}
+
+static void scene_bitmap(Raster &lcd, Raster::Mode mode)
+{
+    for (int16_t i = 0; i < 8; i++) {
+        lcd.blit_bitmap(ring, i * 11 - 5, i * 7 - 4, 12, 12, mode);
+        lcd.draw_bitmap(arrow, i * 11, 40 - i * 5, 10, 6, mode);
+    }
+}
+
+static void scene_rle(Raster &lcd, Raster::Mode mode)
+{
+    lcd.blit_rle(stripes_rle, 8, 8, 12, 16, mode);    // bank aligned
+    lcd.blit_rle(stripes_rle, 30, 13, 12, 16, mode);  // shifted
+    lcd.blit_rle(stripes_rle, -5, 35, 12, 16, mode);  // clipped
+    lcd.blit_rle(stripes_rle, 60, 0, 24, 8, mode);    // blocks across rows
+}
+
+static void scene_text(Raster &lcd, Raster::Mode mode)
+{
+    lcd.print_string("Snake 0123", 1, 1, -1, mode);
+    lcd.print_string("GameOver!", 4, 12, font_small, mode);
+    lcd.print_string("Pause", 10, 22, font_large, mode);
+    lcd.print_string("clipped text", -8, 43, -1, mode);
+    lcd.print_char('Z', lcd.width() - 3, 30, mode);
+}
+
+static void scene_copy(Raster &lcd, Raster::Mode mode)
+{
+    lcd.print_string("copy", 0, 0, font_large, Raster::pixel_copy);
+    lcd.copy_region(0, 0, 40, 16, 30, 20, mode);
+    lcd.copy_region(0, 0, 40, 16, 5, 3, mode);
+    lcd.copy_region(10, 20, 60, 30, -7, 35, mode);
+}
+
+static void scene_scroll(Raster &lcd, Raster::Mode mode)
+{
+    lcd.print_string("scroll", 10, 10, font_large, mode);
+    lcd.scroll_vert(-3 - mode);
+    lcd.scroll_horiz(5 + mode);
+    lcd.scroll_vert(11);
+    lcd.scroll_horiz(-2);
+}
+
+static void scene_composite(Raster &lcd, Raster::Mode mode)
+{
+    static RasterLayer<RASTER_MAX_WIDTH, RASTER_MAX_HEIGHT> bg, fg;
+
+    lcd.save_buffer(bg);
+    lcd.clear_buffer();
+    lcd.fill_circle(lcd.width() / 2, lcd.height() / 2, 20, Raster::pattern_black, Raster::pixel_copy);
+    lcd.save_buffer(fg);
+    lcd.load_buffer(bg);
+    lcd.composite(fg, mode);
+    lcd.composite(bg, fg, (Raster::Mode) (mode ^ Raster::pixel_invt));
+    lcd.composite(fg, mode);
+}
+
+static void scene_clip(Raster &lcd, Raster::Mode mode)
+{
+    lcd.set_clip(10, 5, lcd.width() - 12, lcd.height() - 9);
+    lcd.fill_circle(lcd.width() / 2, lcd.height() / 2, 30, Raster::pattern_black, mode);
+    lcd.draw_line(0, 0, lcd.width() - 1, lcd.height() - 1, Raster::pattern_black, mode);
+    lcd.print_string("clip", 0, 3, font_large, mode);
+    lcd.blit_bitmap(ring, 6, 30, 12, 12, mode);
+    lcd.reset_clip();
+}
+
+// a snake board drawn with the firmware's tile atlas, then a second frame
+// where only the tiles that changed are drawn again, and a sprite on top
+static void scene_tiles(Raster &lcd, Raster::Mode mode)
+{
+    static const uint8_t snake[][2] = {{5, 4}, {6, 4}, {7, 4}, {7, 5}, {7, 6}, {8, 6}};
+    TileMap tiles(lcd, snake_tiles, SNAKE_TILE_SIZE);
+
+    for (uint8_t row = 0; row < tiles.rows(); row++) {
+        for (uint8_t col = 0; col < tiles.cols(); col++) {
+            bool frame = !col || !row || col == tiles.cols() - 1 || row == tiles.rows() - 1;
+            tiles.set_tile(col, row, frame ? tile_frame : tile_empty);
+        }
+    }
+    for (size_t i = 0; i < sizeof(snake) / sizeof(snake[0]); i++) {
+        tiles.set_tile(snake[i][0], snake[i][1], tile_body);
+    }
+    tiles.set_tile(9, 6, tile_head);
+    tiles.set_tile(12, 3, tile_fruit);
+    tiles.set_tile(3, 8, tile_wall);
+    tiles.set_tile(4, 8, tile_wall);
+    tiles.set_tile(14, 7, tile_obstacle);
+    tiles.render(mode);
+
+    tiles.set_tile(5, 4, tile_empty);
+    tiles.set_tile(9, 6, tile_body);
+    tiles.set_tile(10, 6, tile_head);
+    tiles.set_tile(14, 7, tile_empty);
+    tiles.set_tile(15, 7, tile_obstacle);
+    tiles.render(mode);
+    tiles.draw_sprite(ring, 40, 20, 12, 12, mode);
+}
+
+struct scene {
+    const char *name;
+    scene_fn draw;
+};
+
+static const scene scenes[] = {
+    {"pixel", scene_pixel},
+    {"hline", scene_hline},
+    {"vline", scene_vline},
+    {"line", scene_line},
+    {"rect", scene_rect},
+    {"fill_rect", scene_fill_rect},
+    {"rrect", scene_rrect},
+    {"fill_rrect", scene_fill_rrect},
+    {"circle", scene_circle},
+    {"fill_circle", scene_fill_circle},
+    {"ellipse", scene_ellipse},
+    {"fill_ellipse", scene_fill_ellipse},
+    {"bitmap", scene_bitmap},
+    {"rle", scene_rle},
+    {"text", scene_text},
+    {"copy", scene_copy},
+    {"scroll", scene_scroll},
+    {"composite", scene_composite},
+    {"clip", scene_clip},
+    {"tiles", scene_tiles},
+};
+
+// the buffer as a binary PBM: rows MSB first, padded to a byte, 1 is black
+static size_t encode_pbm(const Raster &lcd, uint8_t *out)
+{
+    size_t len = sprintf((char *) out, "P4\n%u %u\n", lcd.width(), lcd.height());
+    uint16_t stride = (lcd.width() + 7) / 8;
+    const uint8_t *buf = lcd.buffer();
+    for (uint8_t y = 0; y < lcd.height(); y++) {
+        uint8_t *row = out + len + y * stride;
+        memset(row, 0, stride);
+        for (uint8_t x = 0; x < lcd.width(); x++) {
+            if (buf[x + (y / 8) * lcd.width()] & (1 << (y % 8))) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+    return len + stride * lcd.height();
+}
+
+static long read_file(const char *path, uint8_t *data, size_t size)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        return -1;
+    }
+    long len = fread(data, 1, size, in);
+    fclose(in);
+    return len;
+}
+
+// FNV-1a, 64 bits: enough to tell a changed image apart
+static uint64_t fnv1a(const uint8_t *data, size_t len)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+#define MAX_SUMS 512
+
+struct sum {
+    char name[64];
+    uint64_t hash;
+};
+
+static sum sums[MAX_SUMS];
+static int sums_count;
+
+static bool read_sums(const char *path)
+{
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        return false;
+    }
+    char line[128];
+    unsigned long long hash;
+    while (sums_count < MAX_SUMS && fgets(line, sizeof(line), in)) {
+        if (line[0] != '#' && sscanf(line, "%63s %llx", sums[sums_count].name, &hash) == 2) {
+            sums[sums_count++].hash = hash;
+        }
+    }
+    fclose(in);
+    return true;
+}
+
+static const sum *find_sum(const char *name)
+{
+    for (int i = 0; i < sums_count; i++) {
+        if (!strcmp(sums[i].name, name)) {
+            return &sums[i];
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned width = 84, height = 48;
+    const char *prefix = "";
+    const char *dir = NULL;
+    const char *sums_path = NULL;
+    bool write = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            if (sscanf(argv[++i], "%ux%u", &width, &height) != 2) {
+                width = 0;
+            }
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if ((!strcmp(argv[i], "-w") || !strcmp(argv[i], "-c")) && i + 1 < argc) {
+            write = argv[i][1] == 'w';
+            dir = argv[++i];
+        } else if ((!strcmp(argv[i], "-W") || !strcmp(argv[i], "-C")) && i + 1 < argc) {
+            write = argv[i][1] == 'W';
+            sums_path = argv[++i];
+        } else {
+            dir = NULL;
+            sums_path = NULL;
+            break;
+        }
+    }
+    if ((!dir && !sums_path) || (dir && sums_path) || width < 4 || width > RASTER_MAX_WIDTH || width % 4 ||
+        height < 8 || height > RASTER_MAX_HEIGHT || height % 8) {
+        fprintf(stderr, "usage: %s [-s WxH] [-p prefix] -w dir | -c dir | -W sums | -C sums\n", argv[0]);
+        return 1;
+    }
+
+    FILE *sums_out = NULL;
+    if (sums_path && write) {
+        sums_out = fopen(sums_path, "w");
+        if (!sums_out) {
+            perror(sums_path);
+            return 1;
+        }
+        fprintf(sums_out, "# snapshot %ux%u, FNV-1a 64 of each PBM, written with -W\n", width, height);
+    } else if (sums_path && !read_sums(sums_path)) {
+        perror(sums_path);
+        return 1;
+    }
+
+    Raster lcd(storage.words, width, height);
+    static uint8_t image[sizeof(storage) * 2 + 32];
+    static uint8_t golden[sizeof(image)];
+    int scenes_run = 0, failed = 0;
+
+    for (size_t s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        if (strncmp(scenes[s].name, prefix, strlen(prefix))) {
+            continue;
+        }
+        for (uint8_t m = 0; m < 8; m++) {
+            char name[64];
+            snprintf(name, sizeof(name), "%s-%s", scenes[s].name, mode_names[m]);
+
+            lcd.reset_clip();
+            lcd.fill_buffer(Raster::pattern_grey);
+            scenes[s].draw(lcd, (Raster::Mode) m);
+            size_t len = encode_pbm(lcd, image);
+            scenes_run++;
+
+            if (sums_path) {
+                uint64_t hash = fnv1a(image, len);
+                if (write) {
+                    fprintf(sums_out, "%s %016llx\n", name, (unsigned long long) hash);
+                    continue;
+                }
+                const sum *golden_sum = find_sum(name);
+                if (!golden_sum) {
+                    printf("%s: not in %s\n", name, sums_path);
+                    failed++;
+                } else if (golden_sum->hash != hash) {
+                    printf("%s: differs from %s\n", name, sums_path);
+                    failed++;
+                }
+                continue;
+            }
+
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s.pbm", dir, name);
+
+            if (write) {
+                FILE *out = fopen(path, "wb");
+                if (!out || fwrite(image, 1, len, out) != len) {
+                    perror(path);
+                    return 1;
+                }
+                fclose(out);
+                continue;
+            }
+
+            long glen = read_file(path, golden, sizeof(golden));
+            if (glen < 0) {
+                printf("%s: missing\n", path);
+                failed++;
+            } else if ((size_t) glen != len || memcmp(image, golden, len)) {
+                size_t i = 0;
+                while (i < len && i < (size_t) glen && image[i] == golden[i]) {
+                    i++;
+                }
+                printf("%s: differs from byte %zu\n", path, i);
+                failed++;
+            }
+        }
+    }
+
+    if (write) {
+        if (sums_out) {
+            fclose(sums_out);
+        }
+        printf("%d images written to %s\n", scenes_run, sums_path ? sums_path : dir);
+        return 0;
+    }
+    printf("%d images, %d differ\n", scenes_run, failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/*
+** EPITECH PROJECT, 2018
+** Alberto Esquer
+** File description:
+** Decodificador de telemetria para el host
+**
+** Build:  g++ -O2 -I../lib/Telemetry telemetry_decode.cpp -o telemetry_decode
+** Usage:  telemetry_decode [capture.bin]   (reads stdin when no file is given)
+**         e.g. stty -F /dev/ttyACM0 115200 raw && telemetry_decode /dev/ttyACM0
+**
+** Tick and boot records are printed as CSV, boot as boot,lcd_us,frame_us. Replay logs are reassembled and saved as
+** replay-<n>.bin in the current directory, ready for tools/replay.cpp.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "TelemetryRecord.h"
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    if (argc > 1) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    TelemetryParser parser;
+    unsigned long records = 0;
+    int c;
+
+    uint8_t replay[0x8000 + REPLAY_CHUNK];
+    unsigned replay_size = 0;
+    int replays = 0;
+
+    printf("type,score,tick_us,frame_bytes,latency_us\n");
+    while ((c = fgetc(in)) != EOF) {
+        if (!parser.feed((uint8_t) c)) {
+            continue;
+        }
+        records++;
+
+        switch (parser.type()) {
+        case telemetry_replay: {
+            if (parser.length() < 2) {
+                break;
+            }
+            unsigned header = parser.payload()[0] | (parser.payload()[1] << 8);
+            unsigned offset = header & ~REPLAY_LAST_CHUNK;
+            unsigned len = parser.length() - 2;
+            if (offset != replay_size) {
+                // a chunk went missing, wait for the start of the next log
+                replay_size = 0;
+                if (offset != 0) {
+                    break;
+                }
+            }
+            memcpy(replay + offset, parser.payload() + 2, len);
+            replay_size = offset + len;
+
+            if (header & REPLAY_LAST_CHUNK) {
+                char name[32];
+                snprintf(name, sizeof(name), "replay-%d.bin", replays++);
+                FILE *out = fopen(name, "wb");
+                if (out) {
+                    fwrite(replay, 1, replay_size, out);
+                    fclose(out);
+                }
+                printf("replay,%s,%u,,\n", name, replay_size);
+                replay_size = 0;
+            }
+            break;
+        }
+        case telemetry_boot:
+            if (parser.length() == BOOT_RECORD_SIZE) {
+                BootRecord rec;
+                boot_record_unpack(parser.payload(), rec);
+                printf("boot,%lu,%lu,,\n", (unsigned long) rec.lcd_us, (unsigned long) rec.frame_us);
+            }
+            break;
+        case telemetry_tick:
+            if (parser.length() == TICK_RECORD_SIZE) {
+                TickRecord rec;
+                tick_record_unpack(parser.payload(), rec);
+                printf("tick,%u,%u,%u,%u\n", rec.score, rec.tick_us, rec.frame_bytes, rec.latency_us);
+                break;
+            }
+            // fall through
+        default:
+            printf("unknown_%02x,,,,\n", parser.type());
+            break;
+        }
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%lu records, %lu bad frames\n", records, parser.errors());
+    return 0;
+}